@@ -131,6 +131,41 @@ static auto ConcurrentOneInsertOneEraseManyContainsQueries(
   }
 }
 
+// Initially insert some numbers
+// One thread updates values, others scan ranges of about a twentieth
+// of the keys each, copying every value under its node's lock
+//
+static auto ConcurrentOneUpdateManyScanQueries(benchmark::State& state)
+    -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-1 * kThousand, 1 * kThousand};
+
+  if (state.thread_index == 0) {
+    concurrent = std::make_unique<SL<int, int>>();
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      concurrent->Insert(dis(gen), dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    if (state.thread_index == 0) {
+      for (auto i = 0; i < kThousand; ++i) {
+        concurrent->Update(dis(gen), [](int& value) { ++value; });
+      }
+    } else {
+      auto lo = dis(gen);
+      auto sum = 0L;
+      concurrent->ForEachInRange(lo, lo + kThousand / 10,
+                                 [&](int, int value) { sum += value; });
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+
+  if (state.thread_index == 0) {
+    concurrent.reset();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////
 //// Run benchmarks
@@ -183,3 +218,15 @@ BENCHMARK(ConcurrentOneInsertOneEraseManyContainsQueries)
     ->Threads(14)
     ->Threads(16)
     ->UseRealTime();
+
+BENCHMARK(ConcurrentOneUpdateManyScanQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
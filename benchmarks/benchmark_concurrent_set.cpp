@@ -82,6 +82,39 @@ static auto ConcurrentOneInsertManyContainsQueries(benchmark::State& state)
   }
 }
 
+// One thread inserts while the others scan ranges of about
+// a twentieth of the set each
+//
+static auto ConcurrentOneInsertManyScanQueries(benchmark::State& state)
+    -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-10 * kThousand, 10 * kThousand};
+
+  if (state.thread_index == 0) {
+    concurrent = std::make_unique<SL<int>>();
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      concurrent->Insert(dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    if (state.thread_index == 0) {
+      for (auto i = 0; i < kThousand; ++i) {
+        concurrent->Insert(dis(gen));
+      }
+    } else {
+      auto lo = dis(gen);
+      auto sum = 0L;
+      concurrent->ForEachInRange(lo, lo + kThousand, [&](int n) { sum += n; });
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+
+  if (state.thread_index == 0) {
+    concurrent.reset();
+  }
+}
+
 BENCHMARK(ConcurrentContainsQueries)
     ->Threads(1)
     ->Threads(2)
@@ -117,3 +150,15 @@ BENCHMARK(ConcurrentOneInsertManyContainsQueries)
     ->Threads(14)
     ->Threads(16)
     ->UseRealTime();
+
+BENCHMARK(ConcurrentOneInsertManyScanQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
@@ -1,6 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "utils/random.hpp"
 
@@ -9,8 +12,13 @@
 template <typename T>
 using GSL = skipper::GuardedSkipListSet<T>;
 
+template <typename T>
+using SGSL = skipper::SharedGuardedSkipListSet<T>;
+
 auto guarded = std::unique_ptr<GSL<int>>{};
+auto shared_guarded = std::unique_ptr<SGSL<int>>{};
 
+static constexpr auto kHundred = 100;
 static constexpr auto kThousand = 1'000;
 
 static auto GuardedContainsQueries(benchmark::State& state) -> void {
@@ -53,6 +61,35 @@ static auto GuardedInsertQueries(benchmark::State& state) -> void {
   }
 }
 
+// Every iteration inserts a sorted batch of a hundred keys under one lock
+static auto GuardedBatchInsertQueries(benchmark::State& state) -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-10 * kThousand, 10 * kThousand};
+
+  if (state.thread_index == 0) {
+    guarded = std::make_unique<GSL<int>>();
+    for (auto i = 0; i < kThousand; ++i) {
+      (*guarded)->Insert(dis(gen));
+    }
+  }
+
+  auto batch = std::vector<int>(kHundred);
+  for (auto _ : state) {
+    std::generate(std::begin(batch), std::end(batch), [&] { return dis(gen); });
+    std::sort(std::begin(batch), std::end(batch));
+    guarded->With([&](auto& skip_list) {
+      for (auto n : batch) {
+        skip_list.Insert(n);
+      }
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * kHundred);
+
+  if (state.thread_index == 0) {
+    guarded.reset();
+  }
+}
+
 static auto GuardedOneInsertManyContainsQueries(benchmark::State& state)
     -> void {
   auto gen = std::mt19937{std::random_device{}()};
@@ -82,6 +119,56 @@ static auto GuardedOneInsertManyContainsQueries(benchmark::State& state)
   }
 }
 
+// Lookups go through a const reference to take the lock in shared mode
+static auto SharedGuardedContainsQueries(benchmark::State& state) -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-10 * kThousand, 10 * kThousand};
+
+  if (state.thread_index == 0) {
+    shared_guarded = std::make_unique<SGSL<int>>();
+    for (auto i = 0; i < kThousand * kThousand; ++i) {
+      (*shared_guarded)->Insert(dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    std::as_const(*shared_guarded)->Find(dis(gen));
+  }
+
+  if (state.thread_index == 0) {
+    shared_guarded.reset();
+  }
+}
+
+static auto SharedGuardedOneInsertManyContainsQueries(benchmark::State& state)
+    -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-10 * kThousand, 10 * kThousand};
+
+  if (state.thread_index == 0) {
+    shared_guarded = std::make_unique<SGSL<int>>();
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      (*shared_guarded)->Insert(dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    if (state.thread_index == 0) {
+      for (auto i = 0; i < kThousand; ++i) {
+        (*shared_guarded)->Insert(dis(gen));
+      }
+    } else {
+      for (auto i = 0; i < kThousand; ++i) {
+        std::as_const(*shared_guarded)->Find(dis(gen));
+      }
+    }
+  }
+
+  if (state.thread_index == 0) {
+    shared_guarded.reset();
+  }
+}
+
 BENCHMARK(GuardedContainsQueries)
     ->Threads(1)
     ->Threads(2)
@@ -106,7 +193,43 @@ BENCHMARK(GuardedInsertQueries)
     ->Threads(16)
     ->UseRealTime();
 
+BENCHMARK(GuardedBatchInsertQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
+
 BENCHMARK(GuardedOneInsertManyContainsQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
+
+BENCHMARK(SharedGuardedContainsQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
+
+BENCHMARK(SharedGuardedOneInsertManyContainsQueries)
     ->Threads(1)
     ->Threads(2)
     ->Threads(4)
@@ -0,0 +1,134 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "utils/random.hpp"
+
+#include "skipper/lock_free_map.hpp"
+
+template <typename Key, typename Value>
+using SL = skipper::LockFreeSkipListMap<Key, Value>;
+
+auto lock_free = std::unique_ptr<SL<int, int>>{};
+
+static constexpr auto kThousand = 1'000;
+
+// Initially insert some numbers
+// Many threads check for contain
+//
+static auto LockFreeManyContainsQueries(benchmark::State& state) -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-1 * kThousand, 1 * kThousand};
+
+  if (state.thread_index == 0) {
+    lock_free = std::make_unique<SL<int, int>>();
+    for (auto i = 0; i < kThousand * kThousand; ++i) {
+      lock_free->Insert(dis(gen), dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    lock_free->Contains(dis(gen));
+  }
+
+  if (state.thread_index == 0) {
+    lock_free.reset();
+  }
+}
+
+// Initially insert some numbers
+// Every thread assigns values to random keys
+//
+static auto LockFreeManyInsertOrAssignQueries(benchmark::State& state)
+    -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-1 * kThousand, 1 * kThousand};
+
+  if (state.thread_index == 0) {
+    lock_free = std::make_unique<SL<int, int>>();
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      lock_free->Insert(dis(gen), dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    lock_free->InsertOrAssign(dis(gen), dis(gen));
+  }
+
+  if (state.thread_index == 0) {
+    lock_free.reset();
+  }
+}
+
+// Initially insert some numbers
+// One thread inserts, second (if exists) erases, others (if exist) check for
+// contain, every action in a loop
+//
+static auto LockFreeOneInsertOneEraseManyContainsQueries(
+    benchmark::State& state) -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-1 * kThousand, 1 * kThousand};
+
+  if (state.thread_index == 0) {
+    lock_free = std::make_unique<SL<int, int>>();
+    for (auto i = 0; i < kThousand * kThousand; ++i) {
+      lock_free->Insert(dis(gen), dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    if (state.thread_index == 0) {
+      for (auto i = 0; i < kThousand; ++i) {
+        lock_free->Insert(dis(gen), dis(gen));
+      }
+    } else if (state.threads > 1 && state.thread_index == 1) {
+      for (auto i = 0; i < kThousand; ++i) {
+        lock_free->Erase(dis(gen));
+      }
+    } else {
+      for (auto i = 0; i < kThousand; ++i) {
+        lock_free->Contains(dis(gen));
+      }
+    }
+  }
+
+  if (state.thread_index == 0) {
+    lock_free.reset();
+  }
+}
+
+BENCHMARK(LockFreeManyContainsQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
+
+BENCHMARK(LockFreeManyInsertOrAssignQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
+
+BENCHMARK(LockFreeOneInsertOneEraseManyContainsQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
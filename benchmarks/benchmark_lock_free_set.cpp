@@ -4,12 +4,14 @@
 
 #include "utils/random.hpp"
 
+#include "skipper/detail/arena.hpp"
 #include "skipper/lock_free_set.hpp"
 
 template <typename T>
 using SL = skipper::LockFreeSkipListSet<T>;
 
 auto lock_free = std::unique_ptr<SL<int>>{};
+auto arena = std::unique_ptr<skipper::detail::Arena>{};
 
 static constexpr auto kThousand = 1'000;
 
@@ -82,6 +84,90 @@ static auto LockFreeOneInsertManyContainsQueries(benchmark::State& state)
   }
 }
 
+// One thread inserts, second (if exists) erases, others (if exist) check for
+// contain, every action in a loop
+//
+static auto LockFreeOneInsertOneEraseManyContainsQueries(
+    benchmark::State& state) -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-10 * kThousand, 10 * kThousand};
+
+  if (state.thread_index == 0) {
+    lock_free = std::make_unique<SL<int>>();
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      lock_free->Insert(dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    if (state.thread_index == 0) {
+      for (auto i = 0; i < kThousand; ++i) {
+        lock_free->Insert(dis(gen));
+      }
+    } else if (state.threads > 1 && state.thread_index == 1) {
+      for (auto i = 0; i < kThousand; ++i) {
+        lock_free->Erase(dis(gen));
+      }
+    } else {
+      for (auto i = 0; i < kThousand; ++i) {
+        lock_free->Contains(dis(gen));
+      }
+    }
+  }
+
+  if (state.thread_index == 0) {
+    lock_free.reset();
+  }
+}
+
+static auto LockFreeOneInsertManyScanQueries(benchmark::State& state) -> void {
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{-10 * kThousand, 10 * kThousand};
+
+  if (state.thread_index == 0) {
+    lock_free = std::make_unique<SL<int>>();
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      lock_free->Insert(dis(gen));
+    }
+  }
+
+  for (auto _ : state) {
+    if (state.thread_index == 0) {
+      for (auto i = 0; i < kThousand; ++i) {
+        lock_free->Insert(dis(gen));
+      }
+    } else {
+      auto lo = dis(gen);
+      auto sum = 0L;
+      lock_free->ForEachInRange(lo, lo + kThousand, [&](int n) { sum += n; });
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+
+  if (state.thread_index == 0) {
+    lock_free.reset();
+  }
+}
+
+// Allocates blocks of a small node without touching any list,
+// so allocator scaling can be told apart from list scaling
+//
+static auto ArenaAllocateQueries(benchmark::State& state) -> void {
+  constexpr auto kBlockSize = std::size_t{32};
+
+  if (state.thread_index == 0) {
+    arena = std::make_unique<skipper::detail::Arena>();
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(arena->Allocate(kBlockSize));
+  }
+
+  if (state.thread_index == 0) {
+    arena.reset();
+  }
+}
+
 BENCHMARK(LockFreeContainsQueries)
     ->Threads(1)
     ->Threads(2)
@@ -117,3 +203,42 @@ BENCHMARK(LockFreeOneInsertManyContainsQueries)
     ->Threads(14)
     ->Threads(16)
     ->UseRealTime();
+
+BENCHMARK(LockFreeOneInsertOneEraseManyContainsQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
+
+BENCHMARK(LockFreeOneInsertManyScanQueries)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
+
+// Blocks are never deallocated, so the number of iterations is fixed
+// to bound what the arena reserves, about 32 MB per thread
+BENCHMARK(ArenaAllocateQueries)
+    ->Iterations(kThousand * kThousand)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(6)
+    ->Threads(8)
+    ->Threads(10)
+    ->Threads(12)
+    ->Threads(14)
+    ->Threads(16)
+    ->UseRealTime();
@@ -1,10 +1,14 @@
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
 #include <set>
 #include <vector>
 
 #include "utils/random.hpp"
 
+#include "skipper/detail/arena.hpp"
 #include "skipper/sequential_set.hpp"
 
 template <typename T>
@@ -40,9 +44,104 @@ static auto SLIntInsertComplexity(benchmark::State& state) -> void {
   state.SetComplexityN(n);
 }
 
+static auto SLIntInsertRangeComplexity(benchmark::State& state) -> void {
+  auto n = state.range(0);
+  auto sorted_numbers =
+      GenerateNumbers(static_cast<std::size_t>(n), 0, 2'000'000);
+  std::sort(std::begin(sorted_numbers), std::end(sorted_numbers));
+
+  for (auto _ : state) {
+    auto skip_list = SL<int>{};
+    skip_list.InsertRange(std::begin(sorted_numbers), std::end(sorted_numbers));
+  }
+
+  state.SetComplexityN(n);
+}
+
+static auto SLIntFromSortedComplexity(benchmark::State& state) -> void {
+  auto n = state.range(0);
+  auto sorted_numbers = std::set<int>{};
+  for (auto number :
+       GenerateNumbers(static_cast<std::size_t>(n), 0, 2'000'000)) {
+    sorted_numbers.insert(number);
+  }
+
+  for (auto _ : state) {
+    auto skip_list = SL<int>::FromSorted(std::begin(sorted_numbers),
+                                         std::end(sorted_numbers));
+    benchmark::DoNotOptimize(skip_list.Begin());
+  }
+
+  state.SetComplexityN(n);
+}
+
 BENCHMARK(SetIntInsertComplexity)
     ->DenseRange(1'000, 10'000, 1'000)
     ->Complexity(benchmark::oNLogN);
 BENCHMARK(SLIntInsertComplexity)
     ->DenseRange(1'000, 10'000, 1'000)
     ->Complexity(benchmark::oNLogN);
+BENCHMARK(SLIntInsertRangeComplexity)
+    ->DenseRange(1'000, 10'000, 1'000)
+    ->Complexity(benchmark::oN);
+BENCHMARK(SLIntFromSortedComplexity)
+    ->DenseRange(1'000, 10'000, 1'000)
+    ->Complexity(benchmark::oN);
+
+template <int TMaxLevel>
+static auto SLIntFindByMaxLevel(benchmark::State& state) -> void {
+  auto n = static_cast<int>(state.range(0));
+  auto skip_list = skipper::SequentialSkipListSet<int, TMaxLevel>{};
+
+  // Descending insertion always lands right after the head,
+  // so the setup stays linear even for the shortest towers.
+  for (auto i = n - 1; i >= 0; --i) {
+    skip_list.Insert(2 * i);
+  }
+
+  auto gen = std::mt19937{std::random_device{}()};
+  auto dis = std::uniform_int_distribution{0, 2 * n};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(skip_list.Find(dis(gen)));
+  }
+}
+
+BENCHMARK_TEMPLATE(SLIntFindByMaxLevel, 4)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Arg(10'000'000);
+BENCHMARK_TEMPLATE(SLIntFindByMaxLevel, 8)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Arg(10'000'000);
+BENCHMARK_TEMPLATE(SLIntFindByMaxLevel, 12)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Arg(10'000'000);
+
+// Nodes go back to the free lists of an arena, instead of `operator delete`
+template <class TAllocator>
+static auto SLIntClear(benchmark::State& state) -> void {
+  using Set = skipper::SequentialSkipListSet<
+      int, 8, skipper::detail::XorShiftLevelGenerator<>, TAllocator>;
+
+  auto n = static_cast<int>(state.range(0));
+  auto numbers = std::vector<int>(static_cast<std::size_t>(n));
+  std::iota(std::begin(numbers), std::end(numbers), 0);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto skip_list = Set::FromSorted(std::begin(numbers), std::end(numbers));
+    state.ResumeTiming();
+
+    skip_list.Clear();
+  }
+}
+
+BENCHMARK_TEMPLATE(SLIntClear, std::allocator<int>)
+    ->Arg(100'000)
+    ->Arg(1'000'000);
+BENCHMARK_TEMPLATE(SLIntClear, skipper::detail::Arena)
+    ->Arg(100'000)
+    ->Arg(1'000'000);
@@ -1,61 +1,146 @@
 #ifndef SKIPPER_CONCURRENT_MAP_HPP
 #define SKIPPER_CONCURRENT_MAP_HPP
 
+#include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <vector>
+#include <utility>
+
+#include "skipper/detail/compare.hpp"
+#include "skipper/detail/epoch.hpp"
+#include "skipper/detail/level_generator.hpp"
+#include "skipper/detail/node_allocator.hpp"
+#include "skipper/detail/spin_lock.hpp"
+#include "skipper/detail/striped_counter.hpp"
+#include "skipper/detail/tower.hpp"
 
 namespace skipper {
 
-template <typename Key, typename Value>
+// Keys are ordered by `TCompare`, see `SequentialSkipListSet`
+template <typename Key, typename Value, int TMaxLevel = 4,
+          class TLevelGenerator = detail::XorShiftLevelGenerator<>,
+          class TLock = detail::SpinLock,
+          class TAllocator = std::allocator<std::pair<const Key, Value>>,
+          class TCompare = std::less<Key>>
 class ConcurrentSkipListMap {
  public:
   using Level = int;
   using Probability = double;
 
-  static constexpr auto kMaxLevel = Level{4};
-  static constexpr auto kProbability = Probability{0.2};
+  static constexpr auto kMaxLevel = Level{TMaxLevel};
+  static constexpr auto kProbability = TLevelGenerator::kProbability;
+
+  static_assert(kMaxLevel >= 0, "Maximum level must be non-negative");
+
+  using AllocatorHandle = typename detail::NodeAllocator<TAllocator>::Handle;
 
  public:
   ConcurrentSkipListMap();
+  explicit ConcurrentSkipListMap(const AllocatorHandle& allocator);
 
   ConcurrentSkipListMap(ConcurrentSkipListMap&& other) = delete;
   ConcurrentSkipListMap(const ConcurrentSkipListMap& other) = delete;
   ConcurrentSkipListMap& operator=(ConcurrentSkipListMap&& other) = delete;
   ConcurrentSkipListMap& operator=(const ConcurrentSkipListMap& other) = delete;
 
-  ~ConcurrentSkipListMap() = default;
+  ~ConcurrentSkipListMap();
 
   auto Contains(const Key& key) -> bool;
   auto Insert(const Key& key, const Value& value) -> bool;
+  auto Insert(Key&& key, Value&& value) -> bool;
   auto Erase(const Key& key) -> bool;
 
+  // Constructs the value from `args` right in a new node if there is
+  // no such key yet, otherwise leaves `args` untouched
+  template <typename... Args>
+  auto TryEmplace(const Key& key, Args&&... args) -> bool;
+  template <typename... Args>
+  auto TryEmplace(Key&& key, Args&&... args) -> bool;
+
+  // Heterogeneous lookups, available with a transparent `TCompare` only
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, Key>>
+  auto Contains(const K& key) -> bool;
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, Key>>
+  auto Erase(const K& key) -> bool;
+
+  // Returns a copy of the value stored under `key`
+  auto Get(const Key& key) -> std::optional<Value>;
+
+  // Call `visitor(const Value&)` or `updater(Value&)` on the value stored
+  // under `key` in place, while holding the node's lock. Both return `false`
+  // if there is no such key. Callbacks must not block or reenter the map:
+  // other threads spin on the lock meanwhile, and a call back into the map
+  // may wait for the lock forever.
+  template <typename TVisitor>
+  auto Visit(const Key& key, TVisitor&& visitor) -> bool;
+  template <typename TUpdater>
+  auto Update(const Key& key, TUpdater&& updater) -> bool;
+
+  // Same as in `ConcurrentSkipListSet`
+  auto Size() -> std::size_t;
+  auto Empty() -> bool;
+  auto MemoryUsage() -> std::size_t;
+
+  // Calls `visitor(const Key&, const Value&)` on keys within [`lo`, `hi`)
+  // in ascending order. Unlike scans of the sets, it is not lock-free:
+  // values change under `Update`, so each one is copied under its node's
+  // lock, and the scan contends with `Update` and `Erase` of that node.
+  // The visitor runs on the copy once the lock is released. Keys inserted
+  // or erased meanwhile may or may not be visited.
+  template <typename TVisitor>
+  auto ForEachInRange(const Key& lo, const Key& hi, TVisitor&& visitor)
+      -> void;
+
  private:
   struct Node;  // Forward declaration for `using` declarations
 
  private:
   using MaybeLevel = std::optional<Level>;
 
-  using NodePtr = std::shared_ptr<Node>;
-  using NodePtrList = std::vector<NodePtr>;
+  using NodePtr = Node*;
+  using NodePtrList =
+      std::array<NodePtr, static_cast<std::size_t>(kMaxLevel) + 1>;
+  using AtomicNodePtr = std::atomic<NodePtr>;
 
   using Flag = std::atomic<bool>;
-  using Lock = std::recursive_mutex;
+  using Lock = TLock;
   using Guard = std::unique_lock<Lock>;
   using MaybeGuard = std::optional<Guard>;
-  using GuardList = std::vector<Guard>;
+  using GuardList = std::array<Guard, static_cast<std::size_t>(kMaxLevel) + 1>;
 
  private:
   struct FindResult;
 
  private:
-  auto Find(const Key& key) -> FindResult;
+  template <typename K>
+  auto Find(const K& key) -> FindResult;
+  template <typename K>
+  auto FindNode(const K& key) -> NodePtr;
   auto GenerateRandomLevel() -> Level;
 
+  template <typename TKey, typename... Args>
+  auto InsertKey(TKey&& key, Args&&... args) -> bool;
+
+  template <typename TKey, typename... Args>
+  auto New(Level level, TKey&& key, Args&&... args) -> NodePtr;
+  auto Delete(NodePtr node) -> void;
+
+ private:
+  using Tower = detail::Tower<Node, AtomicNodePtr>;
+
  private:
-  NodePtr head_{std::make_shared<Node>(Key{}, Value{}, kMaxLevel)};
-  NodePtr tail_{std::make_shared<Node>(Key{}, Value{}, kMaxLevel)};
+  detail::NodeAllocator<TAllocator> allocator_;
+  TCompare compare_{};
+  detail::StripedCounter size_;
+  detail::StripedCounter memory_;
+  NodePtr head_{New(kMaxLevel, Key{})};
+  NodePtr tail_{New(kMaxLevel, Key{})};
+
+  // Reclaims erased nodes
+  detail::EpochManager epochs_;
 };
 
 }  // namespace skipper
@@ -2,6 +2,8 @@
 #define SKIPPER_CONCURRENT_MAP_IPP
 
 #include <algorithm>
+#include <new>
+#include <utility>
 
 #include "skipper/concurrent_set.hpp"
 #include "concurrent_map.hpp"
@@ -10,112 +12,153 @@ namespace skipper {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename Key, typename Value>
-struct ConcurrentSkipListMap<Key, Value>::Node {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+struct ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                             TAllocator, TCompare>::Node {
  public:
-  Node(Key key, Value value, Level level);
+  template <typename TKey, typename... Args>
+  Node(Level l, TKey&& k, Args&&... args);
+
+  auto Forward(std::size_t i) -> AtomicNodePtr&;
 
  public:
   Key key;
   Value value;
   Level level;
-  NodePtrList forward;
 
   Lock lock;
   Flag is_erased{false};  // Is node erased from the list?
   Flag is_linked{false};  // Is node fully linked on all levels?
 };
 
-template <typename Key, typename Value>
-ConcurrentSkipListMap<Key, Value>::Node::Node(Key k, Value val, Level lvl)
-    : key(std::move(k)),
-      value(std::move(val)),
-      level(lvl),
-      forward(static_cast<std::size_t>(lvl) + 1) {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename TKey, typename... Args>
+ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                      TCompare>::Node::Node(Level l, TKey&& k,
+                                              Args&&... args)
+    : key(std::forward<TKey>(k)),
+      value(std::forward<Args>(args)...),
+      level(l) {
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Node::Forward(std::size_t i)
+    -> AtomicNodePtr& {
+  return Tower::Links(this)[i];
 }
 
-template <typename Key, typename Value>
-struct ConcurrentSkipListMap<Key, Value>::FindResult {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+struct ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                             TAllocator, TCompare>::FindResult {
  public:
   MaybeLevel level{std::nullopt};
-  NodePtrList predecessors{static_cast<std::size_t>(kMaxLevel) + 1};
-  NodePtrList successors{static_cast<std::size_t>(kMaxLevel) + 1};
+  NodePtrList predecessors{};
+  NodePtrList successors{};
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename Key, typename Value>
-ConcurrentSkipListMap<Key, Value>::ConcurrentSkipListMap() {
-  std::fill(std::begin(head_->forward), std::end(head_->forward), tail_);
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                      TCompare>::ConcurrentSkipListMap()
+    : ConcurrentSkipListMap(detail::DefaultAllocator<TAllocator>()) {
 }
 
-template <typename Key, typename Value>
-auto ConcurrentSkipListMap<Key, Value>::Contains(const Key& key) -> bool {
-  if (auto [maybe_level, _, successors] = Find(key); !maybe_level) {
-    return false;
-  } else {
-    auto level = static_cast<std::size_t>(maybe_level.value());
-    auto is_linked = successors[level]->is_linked.load();
-    auto is_erased = successors[level]->is_erased.load();
-    return is_linked && !is_erased;
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                      TCompare>::
+    ConcurrentSkipListMap(const AllocatorHandle& allocator)
+    : allocator_(allocator) {
+  for (auto level = 0; level <= kMaxLevel; ++level) {
+    head_->Forward(static_cast<std::size_t>(level)).store(tail_);
   }
 }
 
-template <typename Key, typename Value>
-auto ConcurrentSkipListMap<Key, Value>::Insert(const Key& key,
-                                               const Value& value) -> bool {
-  auto node_level = GenerateRandomLevel();
-
-  while (true) {
-    auto [maybe_level, predecessors, successors] = Find(key);
-    if (maybe_level) {
-      auto level = static_cast<std::size_t>(maybe_level.value());
-      auto node = successors[level];
-
-      if (!node->is_erased.load()) {
-        while (!node->is_linked.load()) {
-        }
-
-        return false;
-      }
-
-      continue;
-    }
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                      TCompare>::~ConcurrentSkipListMap() {
+  for (auto node = head_; node;) {
+    auto next = node->Forward(0).load();
+    Delete(node);
+    node = next;
+  }
+}
 
-    auto guards = GuardList{};
-    auto valid = true;
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Contains(const Key& key)
+    -> bool {
+  return Contains<Key>(key);
+}
 
-    for (auto level = 0; valid && level <= node_level; ++level) {
-      auto i = static_cast<std::size_t>(level);
-      auto pred = predecessors[i];
-      auto succ = successors[i];
-      guards.emplace_back(pred->lock);
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename K, typename>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Contains(const K& key)
+    -> bool {
+  auto epoch_guard = epochs_.Pin();
+  return FindNode(key) != nullptr;
+}
 
-      auto pred_is_erased = pred->is_erased.load();
-      auto succ_is_erased = succ->is_erased.load();
-      auto linked = pred->forward[i] == succ;
-      valid = !pred_is_erased && !succ_is_erased && linked;
-    }
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Insert(
+    const Key& key, const Value& value) -> bool {
+  return InsertKey(key, value);
+}
 
-    if (!valid) {
-      continue;
-    }
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Insert(
+    Key&& key, Value&& value) -> bool {
+  return InsertKey(std::move(key), std::move(value));
+}
 
-    auto node = std::make_shared<Node>(key, value, node_level);
-    for (auto level = 0; level <= node_level; ++level) {
-      auto i = static_cast<std::size_t>(level);
-      node->forward[i] = successors[i];
-      predecessors[i]->forward[i] = node;
-    }
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename... Args>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::TryEmplace(
+    const Key& key, Args&&... args) -> bool {
+  return InsertKey(key, std::forward<Args>(args)...);
+}
 
-    node->is_linked.store(true);
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename... Args>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::TryEmplace(
+    Key&& key, Args&&... args) -> bool {
+  return InsertKey(std::move(key), std::forward<Args>(args)...);
+}
 
-    return true;
-  }
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Erase(const Key& key)
+    -> bool {
+  return Erase<Key>(key);
 }
 
-template <typename Key, typename Value>
-auto ConcurrentSkipListMap<Key, Value>::Erase(const Key& key) -> bool {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename K, typename>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Erase(const K& key) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
   auto candidate = NodePtr{};
   auto maybe_node_level = MaybeLevel{};
   auto maybe_guard = MaybeGuard{};
@@ -153,8 +196,10 @@ auto ConcurrentSkipListMap<Key, Value>::Erase(const Key& key) -> bool {
     for (auto level = 0; valid && level <= maybe_node_level.value(); ++level) {
       auto i = static_cast<std::size_t>(level);
       auto pred = predecessors[i];
-      guards.emplace_back(pred->lock);
-      valid = !pred->is_erased.load() && pred->forward[i] == candidate;
+      if (level == 0 || pred != predecessors[i - 1]) {
+        guards[i] = Guard{pred->lock};
+      }
+      valid = !pred->is_erased.load() && pred->Forward(i).load() == candidate;
     }
 
     if (!valid) {
@@ -163,31 +208,199 @@ auto ConcurrentSkipListMap<Key, Value>::Erase(const Key& key) -> bool {
 
     for (auto level = maybe_node_level.value(); level >= 0; --level) {
       auto i = static_cast<std::size_t>(level);
-      predecessors[i]->forward[i] = candidate->forward[i];
+      predecessors[i]->Forward(i).store(candidate->Forward(i).load());
     }
+    size_.Add(-1);
+
+    epochs_.Retire(
+        candidate,
+        [](void* node, void* map) {
+          static_cast<ConcurrentSkipListMap*>(map)->Delete(
+              static_cast<NodePtr>(node));
+        },
+        this);
 
     return true;
   }
 }
 
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Get(const Key& key)
+    -> std::optional<Value> {
+  auto value = std::optional<Value>{};
+  Update(key, [&value](const Value& v) { value.emplace(v); });
+  return value;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename TVisitor>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Visit(
+    const Key& key, TVisitor&& visitor) -> bool {
+  return Update(key, [&visitor](const Value& value) { visitor(value); });
+}
+
+// Erasion marks the node under its lock, so a node which is not erased
+// once the lock is taken stays in the map until the callback returns.
+//
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename TUpdater>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Update(
+    const Key& key, TUpdater&& updater) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node = FindNode(key);
+  if (!node) {
+    return false;
+  }
+
+  auto guard = Guard{node->lock};
+  if (node->is_erased.load()) {
+    return false;
+  }
+
+  updater(node->value);
+  return true;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Size() -> std::size_t {
+  return static_cast<std::size_t>(std::max(size_.Load(), std::ptrdiff_t{0}));
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Empty() -> bool {
+  return Size() == 0;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::MemoryUsage() -> std::size_t {
+  return static_cast<std::size_t>(
+      std::max(memory_.Load(), std::ptrdiff_t{0}));
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename TVisitor>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::ForEachInRange(
+    const Key& lo, const Key& hi, TVisitor&& visitor) -> void {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node = Find(lo).successors[0];
+  while (node != tail_ && compare_(node->key, hi)) {
+    if (node->is_linked.load()) {
+      auto value = std::optional<Value>{};
+      {
+        auto guard = Guard{node->lock};
+        if (!node->is_erased.load()) {
+          value.emplace(node->value);
+        }
+      }
+      // The key is immutable and the node is not freed while pinned
+      if (value) {
+        visitor(std::as_const(node->key), std::as_const(*value));
+      }
+    }
+    node = node->Forward(0).load();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename Key, typename Value>
-auto ConcurrentSkipListMap<Key, Value>::Find(const Key& key)
+// Same scheme as `ConcurrentSkipListSet::Insert`
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename TKey, typename... Args>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::InsertKey(
+    TKey&& key, Args&&... args) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node_level = GenerateRandomLevel();
+
+  while (true) {
+    auto [maybe_level, predecessors, successors] = Find(key);
+    if (maybe_level) {
+      auto level = static_cast<std::size_t>(maybe_level.value());
+      auto node = successors[level];
+
+      if (!node->is_erased.load()) {
+        while (!node->is_linked.load()) {
+        }
+
+        return false;
+      }
+
+      continue;
+    }
+
+    auto guards = GuardList{};
+    auto valid = true;
+
+    for (auto level = 0; valid && level <= node_level; ++level) {
+      auto i = static_cast<std::size_t>(level);
+      auto pred = predecessors[i];
+      auto succ = successors[i];
+      if (level == 0 || pred != predecessors[i - 1]) {
+        guards[i] = Guard{pred->lock};
+      }
+
+      auto pred_is_erased = pred->is_erased.load();
+      auto succ_is_erased = succ->is_erased.load();
+      auto linked = pred->Forward(i).load() == succ;
+      valid = !pred_is_erased && !succ_is_erased && linked;
+    }
+
+    if (!valid) {
+      continue;
+    }
+
+    auto node = New(node_level, std::forward<TKey>(key),
+                    std::forward<Args>(args)...);
+    for (auto level = 0; level <= node_level; ++level) {
+      auto i = static_cast<std::size_t>(level);
+      node->Forward(i).store(successors[i]);
+      predecessors[i]->Forward(i).store(node);
+    }
+
+    node->is_linked.store(true);
+    size_.Add(1);
+
+    return true;
+  }
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename K>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Find(const K& key)
     -> ConcurrentSkipListMap::FindResult {
   auto result = FindResult{};
   auto pred = head_;
 
   for (auto level = kMaxLevel; level >= 0; --level) {
     auto i = static_cast<std::size_t>(level);
-    auto curr = pred->forward[i];
+    auto curr = pred->Forward(i).load();
 
-    while (curr != tail_ && curr->key < key) {
+    while (curr != tail_ && compare_(curr->key, key)) {
       pred = curr;
-      curr = pred->forward[i];
+      curr = pred->Forward(i).load();
     }
 
-    if (!result.level && curr != tail_ && curr->key == key) {
+    if (!result.level && curr != tail_ && !compare_(key, curr->key)) {
       result.level.emplace(level);
     }
 
@@ -198,15 +411,61 @@ auto ConcurrentSkipListMap<Key, Value>::Find(const Key& key)
   return result;
 }
 
-template <typename Key, typename Value>
-auto ConcurrentSkipListMap<Key, Value>::GenerateRandomLevel()
+// Returns fully linked and not erased node with the given key, if any
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename K>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::FindNode(const K& key)
+    -> ConcurrentSkipListMap::NodePtr {
+  if (auto [maybe_level, _, successors] = Find(key); !maybe_level) {
+    return nullptr;
+  } else {
+    auto node = successors[static_cast<std::size_t>(maybe_level.value())];
+    auto is_linked = node->is_linked.load();
+    auto is_erased = node->is_erased.load();
+    return is_linked && !is_erased ? node : nullptr;
+  }
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::GenerateRandomLevel()
     -> ConcurrentSkipListMap::Level {
-  auto level = Level{0};
-  while (level < kMaxLevel &&
-         static_cast<Probability>(std::rand()) / RAND_MAX < kProbability) {
-    ++level;
+  return TLevelGenerator::Generate(kMaxLevel);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+template <typename TKey, typename... Args>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::New(
+    Level level, TKey&& key, Args&&... args)
+    -> ConcurrentSkipListMap::NodePtr {
+  auto size = Tower::AllocationSize(level);
+  auto raw = allocator_.Allocate(size);
+  try {
+    auto node = Tower::Construct(raw, level, level, std::forward<TKey>(key),
+                                 std::forward<Args>(args)...);
+    memory_.Add(static_cast<std::ptrdiff_t>(allocator_.Footprint(size)));
+    return node;
+  } catch (...) {
+    allocator_.Deallocate(raw, size);
+    throw;
   }
-  return level;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TLock, class TAllocator, class TCompare>
+auto ConcurrentSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TLock,
+                           TAllocator, TCompare>::Delete(
+    ConcurrentSkipListMap::NodePtr node) -> void {
+  auto level = node->level;
+  auto size = Tower::AllocationSize(level);
+  Tower::Destroy(node, level);
+  allocator_.Deallocate(node, size);
+  memory_.Add(-static_cast<std::ptrdiff_t>(allocator_.Footprint(size)));
 }
 
 }  // namespace skipper
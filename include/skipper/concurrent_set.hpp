@@ -1,63 +1,141 @@
 #ifndef SKIPPER_CONCURRENT_SET_HPP
 #define SKIPPER_CONCURRENT_SET_HPP
 
+#include <array>
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <vector>
+
+#include "skipper/detail/compare.hpp"
+#include "skipper/detail/epoch.hpp"
+#include "skipper/detail/level_generator.hpp"
+#include "skipper/detail/node_allocator.hpp"
+#include "skipper/detail/spin_lock.hpp"
+#include "skipper/detail/striped_counter.hpp"
+#include "skipper/detail/tower.hpp"
 
 namespace skipper {
 
-template <typename T>
+// Values are ordered by `TCompare`, see `SequentialSkipListSet`.
+//
+// `TLock` guards a single node and has to be Lockable. It does not need
+// to be recursive: a predecessor shared by several levels is locked once.
+//
+// Nodes are allocated from `TAllocator` by every thread at once, so it has to
+// be thread-safe, e.g. `std::pmr::synchronized_pool_resource` will do.
+template <typename T, int TMaxLevel = 4,
+          class TLevelGenerator = detail::XorShiftLevelGenerator<>,
+          class TLock = detail::SpinLock,
+          class TAllocator = std::allocator<T>, class TCompare = std::less<T>>
 class ConcurrentSkipListSet {
  public:
   using Level = int;
   using Probability = double;
 
-  static constexpr auto kMaxLevel = Level{4};
-  static constexpr auto kProbability = Probability{0.2};
+  static constexpr auto kMaxLevel = Level{TMaxLevel};
+  static constexpr auto kProbability = TLevelGenerator::kProbability;
+
+  static_assert(kMaxLevel >= 0, "Maximum level must be non-negative");
+
+  using AllocatorHandle = typename detail::NodeAllocator<TAllocator>::Handle;
 
  public:
   ConcurrentSkipListSet();
+  explicit ConcurrentSkipListSet(const AllocatorHandle& allocator);
 
   ConcurrentSkipListSet(ConcurrentSkipListSet&& other) = delete;
   ConcurrentSkipListSet(const ConcurrentSkipListSet& other) = delete;
   ConcurrentSkipListSet& operator=(ConcurrentSkipListSet&& other) = delete;
   ConcurrentSkipListSet& operator=(const ConcurrentSkipListSet& other) = delete;
 
-  ~ConcurrentSkipListSet() = default;
+  ~ConcurrentSkipListSet();
 
   auto Contains(const T& value) -> bool;
   auto Insert(const T& value) -> bool;
+  auto Insert(T&& value) -> bool;
   auto Erase(const T& value) -> bool;
 
+  // Constructs a value from `args` and moves it into a new node,
+  // which is allocated only if there is no equal value yet
+  template <typename... Args>
+  auto Emplace(Args&&... args) -> bool;
+
+  // Heterogeneous lookups, available with a transparent `TCompare` only
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, T>>
+  auto Contains(const K& key) -> bool;
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, T>>
+  auto Erase(const K& key) -> bool;
+
+  // Number of values, exact while no update is in progress, otherwise
+  // concurrent updates may or may not be counted. Threads count their
+  // updates separately, so this sums up a counter per thread.
+  auto Size() -> std::size_t;
+  auto Empty() -> bool;
+
+  // Bytes taken from the allocator by nodes and sentinels, erased nodes
+  // which are not freed yet included. Every block is counted rounded up
+  // as the allocator does it.
+  auto MemoryUsage() -> std::size_t;
+
+  // Calls `visitor(const T&)` on values within [`lo`, `hi`) in ascending
+  // order. The scan takes no locks and runs alongside updates, so values
+  // inserted or erased meanwhile may or may not be visited.
+  template <typename TVisitor>
+  auto ForEachInRange(const T& lo, const T& hi, TVisitor&& visitor) -> void;
+
  private:
   struct Node;  // Forward declaration for `using` declarations
 
  private:
   using MaybeLevel = std::optional<Level>;
 
-  using NodePtr = std::shared_ptr<Node>;
-  using NodePtrList = std::vector<NodePtr>;
+  using NodePtr = Node*;
+  using NodePtrList =
+      std::array<NodePtr, static_cast<std::size_t>(kMaxLevel) + 1>;
+  using AtomicNodePtr = std::atomic<NodePtr>;
 
   using Flag = std::atomic<bool>;
-  using Lock = std::recursive_mutex;
+  using Lock = TLock;
   using Guard = std::unique_lock<Lock>;
   using MaybeGuard = std::optional<Guard>;
-  using GuardList = std::vector<Guard>;
+  // Indexed by level, a predecessor already locked on a lower level
+  // leaves its slot empty
+  using GuardList = std::array<Guard, static_cast<std::size_t>(kMaxLevel) + 1>;
 
  private:
   struct FindResult;
 
  private:
-  auto Find(const T& value) -> FindResult;
+  template <typename K>
+  auto Find(const K& key) -> FindResult;
 
   auto GenerateRandomLevel() -> Level;
 
+  template <typename TValue>
+  auto InsertValue(TValue&& value) -> bool;
+
+  template <typename... Args>
+  auto New(Level level, Args&&... args) -> NodePtr;
+  auto Delete(NodePtr node) -> void;
+
+ private:
+  using Tower = detail::Tower<Node, AtomicNodePtr>;
+
  private:
-  NodePtr head_{std::make_shared<Node>(T{}, kMaxLevel)};
-  NodePtr tail_{std::make_shared<Node>(T{}, kMaxLevel)};
+  detail::NodeAllocator<TAllocator> allocator_;
+  TCompare compare_{};
+  // Updated by every insertion and erasure, hence striped per thread
+  // instead of making all writers contend for a single cache line
+  detail::StripedCounter size_;
+  detail::StripedCounter memory_;
+  NodePtr head_{New(kMaxLevel)};
+  NodePtr tail_{New(kMaxLevel)};
+
+  // Erased nodes might still be visited by concurrent readers,
+  // hence they are freed only once every reader has moved on
+  detail::EpochManager epochs_;
 };
 
 }  // namespace skipper
@@ -2,6 +2,8 @@
 #define SKIPPER_CONCURRENT_SET_IPP
 
 #include <algorithm>
+#include <new>
+#include <utility>
 
 #include "skipper/concurrent_set.hpp"
 
@@ -9,48 +11,99 @@ namespace skipper {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-struct ConcurrentSkipListSet<T>::Node {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+struct ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                             TCompare>::Node {
  public:
-  Node(T v, Level level);
+  template <typename... Args>
+  explicit Node(Level l, Args&&... args);
+
+  auto Forward(std::size_t i) -> AtomicNodePtr&;
 
  public:
   T value;
   Level level;
-  NodePtrList forward;
 
   Lock lock;
   Flag is_erased{false};  // Is node erased from the list?
   Flag is_linked{false};  // Is node fully linked on all levels?
 };
 
-template <typename T>
-ConcurrentSkipListSet<T>::Node::Node(T val, Level lvl)
-    : value(std::move(val)),
-      level(lvl),
-      forward(static_cast<std::size_t>(lvl) + 1) {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+template <typename... Args>
+ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                      TCompare>::Node::Node(Level l, Args&&... args)
+    : value(std::forward<Args>(args)...), level(l) {
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Node::Forward(std::size_t i)
+    -> AtomicNodePtr& {
+  return Tower::Links(this)[i];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-struct ConcurrentSkipListSet<T>::FindResult {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+struct ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                             TCompare>::FindResult {
  public:
   MaybeLevel level{std::nullopt};
-  NodePtrList predecessors{static_cast<std::size_t>(kMaxLevel) + 1};
-  NodePtrList successors{static_cast<std::size_t>(kMaxLevel) + 1};
+  NodePtrList predecessors{};
+  NodePtrList successors{};
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-ConcurrentSkipListSet<T>::ConcurrentSkipListSet() {
-  std::fill(std::begin(head_->forward), std::end(head_->forward), tail_);
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                      TCompare>::ConcurrentSkipListSet()
+    : ConcurrentSkipListSet(detail::DefaultAllocator<TAllocator>()) {
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                      TCompare>::
+    ConcurrentSkipListSet(const AllocatorHandle& allocator)
+    : allocator_(allocator) {
+  for (auto level = 0; level <= kMaxLevel; ++level) {
+    head_->Forward(static_cast<std::size_t>(level)).store(tail_);
+  }
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                      TCompare>::~ConcurrentSkipListSet() {
+  for (auto node = head_; node;) {
+    auto next = node->Forward(0).load();
+    Delete(node);
+    node = next;
+  }
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Contains(const T& value) -> bool {
+  return Contains<T>(value);
 }
 
-template <typename T>
-auto ConcurrentSkipListSet<T>::Contains(const T& value) -> bool {
-  if (auto [maybe_level, _, successors] = Find(value); !maybe_level) {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+template <typename K, typename>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Contains(const K& key) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
+  if (auto [maybe_level, _, successors] = Find(key); !maybe_level) {
     return false;
   } else {
     auto level = static_cast<std::size_t>(maybe_level.value());
@@ -60,65 +113,33 @@ auto ConcurrentSkipListSet<T>::Contains(const T& value) -> bool {
   }
 }
 
-// Start with finding predecessors and successors for the node,
-// which will be (possibly) inserted.
-//
-// If such node is already present and not yet erased,
-// spin until it is fully linked. Otherwise, start again.
-//
-// Now verify that all of the node's predecessors and successors
-// are fully linked, not erased and adjacent to each other.
-// Return if not. Otherwise, insert the node and mark it as fully linked.
-//
-template <typename T>
-auto ConcurrentSkipListSet<T>::Insert(const T& value) -> bool {
-  auto node_level = GenerateRandomLevel();
-
-  while (true) {
-    auto [maybe_level, predecessors, successors] = Find(value);
-    if (maybe_level) {
-      auto level = static_cast<std::size_t>(maybe_level.value());
-      auto node = successors[level];
-
-      if (!node->is_erased.load()) {
-        while (!node->is_linked.load()) {
-        }
-
-        return false;
-      }
-
-      continue;
-    }
-
-    auto guards = GuardList{};
-    auto valid = true;
-
-    for (auto level = 0; valid && level <= node_level; ++level) {
-      auto i = static_cast<std::size_t>(level);
-      auto pred = predecessors[i];
-      auto succ = successors[i];
-      guards.emplace_back(pred->lock);
-
-      auto pred_is_erased = pred->is_erased.load();
-      auto succ_is_erased = succ->is_erased.load();
-      auto linked = pred->forward[i] == succ;
-      valid = !pred_is_erased && !succ_is_erased && linked;
-    }
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Insert(const T& value) -> bool {
+  return InsertValue(value);
+}
 
-    if (!valid) {
-      continue;
-    }
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Insert(T&& value) -> bool {
+  return InsertValue(std::move(value));
+}
 
-    auto node = std::make_shared<Node>(value, node_level);
-    for (auto level = 0; level <= node_level; ++level) {
-      auto i = static_cast<std::size_t>(level);
-      node->forward[i] = successors[i];
-      predecessors[i]->forward[i] = node;
-    }
-    node->is_linked.store(true);
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+template <typename... Args>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Emplace(Args&&... args) -> bool {
+  return InsertValue(T(std::forward<Args>(args)...));
+}
 
-    return true;
-  }
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Erase(const T& value) -> bool {
+  return Erase<T>(value);
 }
 
 // First, find possible candidate for erasion by calling `Find`.
@@ -132,14 +153,19 @@ auto ConcurrentSkipListSet<T>::Insert(const T& value) -> bool {
 // physically remove candidate from the list.
 // Otherwise, collect new predecessors of the candidate while holding the lock.
 //
-template <typename T>
-auto ConcurrentSkipListSet<T>::Erase(const T& value) -> bool {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+template <typename K, typename>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Erase(const K& key) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
   auto candidate = NodePtr{};
   auto maybe_node_level = MaybeLevel{};
   auto maybe_guard = MaybeGuard{};
 
   while (true) {
-    auto [maybe_level, predecessors, successors] = Find(value);
+    auto [maybe_level, predecessors, successors] = Find(key);
     if (maybe_level) {
       auto level = static_cast<std::size_t>(maybe_level.value());
       candidate = successors[level];
@@ -170,8 +196,10 @@ auto ConcurrentSkipListSet<T>::Erase(const T& value) -> bool {
     for (auto level = 0; valid && level <= maybe_node_level.value(); ++level) {
       auto i = static_cast<std::size_t>(level);
       auto pred = predecessors[i];
-      guards.emplace_back(pred->lock);
-      valid = !pred->is_erased.load() && pred->forward[i] == candidate;
+      if (level == 0 || pred != predecessors[i - 1]) {
+        guards[i] = Guard{pred->lock};
+      }
+      valid = !pred->is_erased.load() && pred->Forward(i).load() == candidate;
     }
 
     if (!valid) {
@@ -180,17 +208,145 @@ auto ConcurrentSkipListSet<T>::Erase(const T& value) -> bool {
 
     for (auto level = maybe_node_level.value(); level >= 0; --level) {
       auto i = static_cast<std::size_t>(level);
-      predecessors[i]->forward[i] = candidate->forward[i];
+      predecessors[i]->Forward(i).store(candidate->Forward(i).load());
     }
+    size_.Add(-1);
+
+    epochs_.Retire(
+        candidate,
+        [](void* node, void* set) {
+          static_cast<ConcurrentSkipListSet*>(set)->Delete(
+              static_cast<NodePtr>(node));
+        },
+        this);
 
     return true;
   }
 }
 
+// A value inserted and erased by different threads while the stripes are
+// summed up may be seen erased only, so the sum is clamped at zero
+//
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Size() -> std::size_t {
+  return static_cast<std::size_t>(std::max(size_.Load(), std::ptrdiff_t{0}));
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Empty() -> bool {
+  return Size() == 0;
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::MemoryUsage() -> std::size_t {
+  return static_cast<std::size_t>(
+      std::max(memory_.Load(), std::ptrdiff_t{0}));
+}
+
+// Walks the lowest level starting from the successor found by `Find`.
+// Erased nodes keep their links, and the pinned epoch keeps them alive,
+// hence the walk may safely pass through nodes erased meanwhile.
+//
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+template <typename TVisitor>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::ForEachInRange(
+    const T& lo, const T& hi, TVisitor&& visitor) -> void {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node = Find(lo).successors[0];
+  while (node != tail_ && compare_(node->value, hi)) {
+    if (node->is_linked.load() && !node->is_erased.load()) {
+      visitor(std::as_const(node->value));
+    }
+    node = node->Forward(0).load();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-auto ConcurrentSkipListSet<T>::Find(const T& value)
+// Start with finding predecessors and successors for the node,
+// which will be (possibly) inserted.
+//
+// If such node is already present and not yet erased,
+// spin until it is fully linked. Otherwise, start again.
+//
+// Now verify that all of the node's predecessors and successors
+// are fully linked, not erased and adjacent to each other.
+// Return if not. Otherwise, insert the node and mark it as fully linked.
+//
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+template <typename TValue>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::InsertValue(TValue&& value) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node_level = GenerateRandomLevel();
+
+  while (true) {
+    auto [maybe_level, predecessors, successors] = Find(value);
+    if (maybe_level) {
+      auto level = static_cast<std::size_t>(maybe_level.value());
+      auto node = successors[level];
+
+      if (!node->is_erased.load()) {
+        while (!node->is_linked.load()) {
+        }
+
+        return false;
+      }
+
+      continue;
+    }
+
+    auto guards = GuardList{};
+    auto valid = true;
+
+    for (auto level = 0; valid && level <= node_level; ++level) {
+      auto i = static_cast<std::size_t>(level);
+      auto pred = predecessors[i];
+      auto succ = successors[i];
+      if (level == 0 || pred != predecessors[i - 1]) {
+        guards[i] = Guard{pred->lock};
+      }
+
+      auto pred_is_erased = pred->is_erased.load();
+      auto succ_is_erased = succ->is_erased.load();
+      auto linked = pred->Forward(i).load() == succ;
+      valid = !pred_is_erased && !succ_is_erased && linked;
+    }
+
+    if (!valid) {
+      continue;
+    }
+
+    // Nothing reads `value` past this point, so it may be moved from
+    auto node = New(node_level, std::forward<TValue>(value));
+    for (auto level = 0; level <= node_level; ++level) {
+      auto i = static_cast<std::size_t>(level);
+      node->Forward(i).store(successors[i]);
+      predecessors[i]->Forward(i).store(node);
+    }
+    node->is_linked.store(true);
+    size_.Add(1);
+
+    return true;
+  }
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+template <typename K>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Find(const K& key)
     -> ConcurrentSkipListSet::FindResult {
   auto result = FindResult{};
 
@@ -199,13 +355,15 @@ auto ConcurrentSkipListSet<T>::Find(const T& value)
   for (auto level = kMaxLevel; level >= 0; --level) {
     auto i = static_cast<std::size_t>(level);
 
-    auto curr = pred->forward[i];
-    while (curr != tail_ && curr->value < value) {
+    auto curr = pred->Forward(i).load();
+    while (curr != tail_ && compare_(curr->value, key)) {
       pred = curr;
-      curr = pred->forward[i];
+      curr = pred->Forward(i).load();
     }
 
-    if (!result.level && curr != tail_ && curr->value == value) {
+    // `curr` does not precede `key`, hence they are equal unless `key`
+    // precedes `curr`
+    if (!result.level && curr != tail_ && !compare_(key, curr->value)) {
       result.level.emplace(level);
     }
 
@@ -216,15 +374,43 @@ auto ConcurrentSkipListSet<T>::Find(const T& value)
   return result;
 }
 
-template <typename T>
-auto ConcurrentSkipListSet<T>::GenerateRandomLevel()
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::GenerateRandomLevel()
     -> ConcurrentSkipListSet::Level {
-  auto level = Level{0};
-  while (level < kMaxLevel &&
-         static_cast<Probability>(std::rand()) / RAND_MAX < kProbability) {
-    ++level;
+  return TLevelGenerator::Generate(kMaxLevel);
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+template <typename... Args>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::New(Level level, Args&&... args)
+    -> ConcurrentSkipListSet::NodePtr {
+  auto size = Tower::AllocationSize(level);
+  auto raw = allocator_.Allocate(size);
+  try {
+    auto node =
+        Tower::Construct(raw, level, level, std::forward<Args>(args)...);
+    memory_.Add(static_cast<std::ptrdiff_t>(allocator_.Footprint(size)));
+    return node;
+  } catch (...) {
+    allocator_.Deallocate(raw, size);
+    throw;
   }
-  return level;
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TLock,
+          class TAllocator, class TCompare>
+auto ConcurrentSkipListSet<T, TMaxLevel, TLevelGenerator, TLock, TAllocator,
+                           TCompare>::Delete(
+    ConcurrentSkipListSet::NodePtr node) -> void {
+  auto level = node->level;
+  auto size = Tower::AllocationSize(level);
+  Tower::Destroy(node, level);
+  allocator_.Deallocate(node, size);
+  memory_.Add(-static_cast<std::ptrdiff_t>(allocator_.Footprint(size)));
 }
 
 }  // namespace skipper
@@ -2,15 +2,34 @@
 #define SKIPPER_DETAIL_ALLOCATOR_HPP
 
 #include <cstddef>  // std::size_t
+#include <type_traits>
 
 namespace skipper::detail {
 
 struct Allocator {
+  // Returns memory aligned to `alignof(std::max_align_t)`, throws or returns
+  // `nullptr` if it is exhausted
   virtual auto Allocate(std::size_t bytes) -> char* = 0;
 
+  // Returns memory obtained from `Allocate(bytes)`
+  virtual auto Deallocate(char* raw, std::size_t bytes) -> void = 0;
+
   virtual ~Allocator() = default;
 };
 
+// Allocators which release all memory at once when destroyed declare
+// `static constexpr bool kReleasesInBulk`. Containers which go away along
+// with the last handle to such an allocator need not free their nodes one
+// by one. Blocks which are not deallocated are not reused, so containers
+// sharing the allocator with others still do.
+template <class TAllocator, typename = void>
+inline constexpr auto kReleasesInBulk = false;
+
+template <class TAllocator>
+inline constexpr auto kReleasesInBulk<
+    TAllocator, std::void_t<decltype(TAllocator::kReleasesInBulk)>> =
+    bool{TAllocator::kReleasesInBulk};
+
 }  // namespace skipper::detail
 
 #endif  // SKIPPER_DETAIL_ALLOCATOR_HPP
@@ -1,37 +1,126 @@
 #ifndef SKIPPER_DETAIL_ARENA_HPP
 #define SKIPPER_DETAIL_ARENA_HPP
 
+#include <array>
 #include <atomic>
-#include <memory>
+#include <cstddef>  // std::max_align_t, std::size_t
+#include <limits>
+#include <new>
 
 #include "skipper/detail/allocator.hpp"
+#include "skipper/detail/per_thread.hpp"
+#include "skipper/detail/spin_lock.hpp"
 
 namespace skipper::detail {
 
+// Carves blocks out of large slabs with a single atomic bump of the cursor
+// of the current slab. Once it is used up, a new slab is chained in front
+// of it. Slabs are released all at once by the destructor.
+//
+// Threads do not bump the shared cursor for every block: each of them takes
+// a buffer of `kBufferSize` bytes at once and carves its blocks out of it.
+// Blocks larger than a slab get a dedicated one.
+//
+// Deallocated blocks of up to `kMaxReusedSize` bytes are kept in free lists
+// of the deallocating thread, one per size class, and handed out again by
+// its next allocations of the same size. A thread which frees more than it
+// allocates passes `kBatchSize` blocks at a time on to a list of the arena
+// shared by all threads, where others pick them up once their lists run dry.
+// Larger blocks are not reused. Either way, memory goes back to the system
+// only when the arena is destroyed.
 class Arena : public Allocator {
- private:
-  struct Cell;
+ public:
+  // Thrown once slabs would take more memory than the budget allows
+  class BudgetExceeded : public std::bad_alloc {
+   public:
+    auto what() const noexcept -> const char* override;
+  };
 
  public:
-  static constexpr auto kMaxSize = 10'000'000;
+  static constexpr auto kSlabSize = std::size_t{1} << 20;
+  static constexpr auto kBufferSize = std::size_t{16} << 10;
+
+  // Every block is aligned as if it was allocated by `new`
+  static constexpr auto kAlignment = alignof(std::max_align_t);
+
+  static constexpr auto kMaxReusedSize = std::size_t{1} << 10;
+  static constexpr auto kBatchSize = std::size_t{32};
+
+  static constexpr auto kUnlimited = std::numeric_limits<std::size_t>::max();
+
+  // See `detail::kReleasesInBulk`
+  static constexpr auto kReleasesInBulk = true;
 
  public:
   Arena() = default;
 
+  // Memory is taken a slab at a time, so that is the granularity of `budget`
+  explicit Arena(std::size_t budget);
+
   // Copying is not allowed
   Arena(const Arena& other) = delete;
   Arena& operator=(const Arena& other) = delete;
 
+  ~Arena() override;
+
   // Allocator interface
   auto Allocate(std::size_t bytes) -> char* override;
+  auto Deallocate(char* raw, std::size_t bytes) -> void override;
+
+  // Bytes of slabs taken from the system so far, headers aside.
+  // Deallocated blocks are counted too, as slabs are never returned.
+  auto Reserved() const -> std::size_t;
 
  private:
-  using Memory = std::vector<Cell>;
-  using Cursor = std::atomic<std::size_t>;
+  struct Slab;
+  struct Buffer;
+  struct FreeList;
+
+  // Batches of free blocks of a single size class shared by all threads.
+  // The first block of a batch links to the next batch by its second word.
+  struct alignas(64) Batches {
+    SpinLock lock;
+    char* head{nullptr};
+  };
 
  private:
-  Memory memory_{kMaxSize};
-  Cursor cursor_{0};
+  using SlabPtr = Slab*;
+  using AtomicSlabPtr = std::atomic<SlabPtr>;
+  using Counter = std::atomic<std::size_t>;
+
+  static constexpr auto kSizeClasses = kMaxReusedSize / kAlignment;
+
+ private:
+  // Bumps the cursor of the current slab,
+  // `size` must be a multiple of `kAlignment`
+  auto AllocateShared(std::size_t size) -> char*;
+
+  // Throws `BudgetExceeded` if there is no room for `size` more bytes
+  auto NewSlab(std::size_t size) -> SlabPtr;
+  auto DeleteSlab(SlabPtr slab) -> void;
+
+  static auto Push(AtomicSlabPtr& list, SlabPtr slab) -> void;
+
+  // Pops a free block off the calling thread's list of its size class,
+  // refilling the list from `batches_` if needed. Returns `nullptr` if
+  // there is no free block of that size.
+  auto Reuse(std::size_t size) -> char*;
+  // Pushes `block` onto the calling thread's list, spilling a batch
+  // into `batches_` once the list grows too long
+  auto Recycle(char* block, std::size_t size) -> void;
+
+  static auto SizeClass(std::size_t size) -> std::size_t;
+  static auto Links(char* block) -> char**;
+
+ private:
+  std::size_t budget_{kUnlimited};
+  Counter reserved_{0};
+
+  AtomicSlabPtr current_{nullptr};
+  AtomicSlabPtr dedicated_{nullptr};
+
+  PerThread<Buffer> buffers_;
+  std::array<Batches, kSizeClasses> batches_;
 };
 
 }  // namespace skipper::detail
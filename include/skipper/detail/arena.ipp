@@ -1,36 +1,204 @@
 #ifndef SKIPPER_DETAIL_ARENA_IPP
 #define SKIPPER_DETAIL_ARENA_IPP
 
+#include <mutex>
+#include <new>
+#include <utility>
+
 #include "skipper/detail/arena.hpp"
 
 namespace skipper::detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-struct Arena::Cell {
+// Header of a single allocation, blocks are carved out right after it
+struct alignas(Arena::kAlignment) Arena::Slab {
  public:
-  ~Cell();
+  auto Data() -> char*;
 
  public:
-  char* raw{nullptr};
+  std::size_t size;
+  Counter cursor{0};
+  SlabPtr next{nullptr};
 };
 
-Arena::Cell::~Cell() {
-  delete[] raw;
+inline auto Arena::Slab::Data() -> char* {
+  return reinterpret_cast<char*>(this + 1);
 }
 
+// A free block keeps the next one of its list in its first word
+struct Arena::FreeList {
+  char* head{nullptr};
+  std::size_t length{0};
+};
+
+// Written by a single thread only, hence aligned to avoid false sharing
+struct alignas(64) Arena::Buffer {
+  char* begin{nullptr};
+  char* end{nullptr};
+  std::array<FreeList, kSizeClasses> free{};
+};
+
+static_assert(Arena::kAlignment >= 2 * sizeof(char*),
+              "Free blocks keep two links");
+
 ////////////////////////////////////////////////////////////////////////////////
 
-auto Arena::Allocate(std::size_t bytes) -> char* {
-  auto c = cursor_.fetch_add(1);
-  if (c >= kMaxSize) {
-    return nullptr;
+inline auto Arena::BudgetExceeded::what() const noexcept -> const char* {
+  return "Arena memory budget exceeded";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline Arena::Arena(std::size_t budget) : budget_(budget) {
+}
+
+inline Arena::~Arena() {
+  for (auto list : {current_.load(), dedicated_.load()}) {
+    while (list) {
+      DeleteSlab(std::exchange(list, list->next));
+    }
+  }
+}
+
+inline auto Arena::Allocate(std::size_t bytes) -> char* {
+  auto size = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  if (size > kSlabSize) {
+    auto slab = NewSlab(size);
+    Push(dedicated_, slab);
+    return slab->Data();
   }
 
-  auto& cell = memory_[c];
-  cell.raw = new char[bytes];
+  if (size > kBufferSize) {
+    return AllocateShared(size);
+  }
+
+  if (size != 0 && size <= kMaxReusedSize) {
+    if (auto block = Reuse(size)) {
+      return block;
+    }
+  }
+
+  auto& buffer = buffers_.Local();
+
+  // Tail of the previous buffer is abandoned
+  if (static_cast<std::size_t>(buffer.end - buffer.begin) < size) {
+    buffer.begin = AllocateShared(kBufferSize);
+    buffer.end = buffer.begin + kBufferSize;
+  }
+
+  auto block = buffer.begin;
+  buffer.begin += size;
+
+  return block;
+}
+
+// Larger blocks are left alone until the arena is destroyed
+inline auto Arena::Deallocate(char* raw, std::size_t bytes) -> void {
+  auto size = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  if (size != 0 && size <= kMaxReusedSize) {
+    Recycle(raw, size);
+  }
+}
+
+inline auto Arena::Reserved() const -> std::size_t {
+  return reserved_.load();
+}
+
+// Cursor of a used up slab keeps growing past its end
+// until the slab is replaced by a new one
+inline auto Arena::AllocateShared(std::size_t size) -> char* {
+  while (true) {
+    auto slab = current_.load(std::memory_order_acquire);
+    if (slab) {
+      auto offset = slab->cursor.fetch_add(size);
+      if (offset + size <= slab->size) {
+        return slab->Data() + offset;
+      }
+    }
+
+    auto fresh = NewSlab(kSlabSize);
+    fresh->next = slab;
+    if (!current_.compare_exchange_strong(slab, fresh,
+                                          std::memory_order_acq_rel)) {
+      DeleteSlab(fresh);
+    }
+  }
+}
+
+inline auto Arena::NewSlab(std::size_t size) -> SlabPtr {
+  auto reserved = reserved_.fetch_add(size);
+  if (size > budget_ || reserved > budget_ - size) {
+    reserved_.fetch_sub(size);
+    throw BudgetExceeded{};
+  }
+
+  try {
+    auto raw = new char[sizeof(Slab) + size];
+    return new (raw) Slab{size};
+  } catch (...) {
+    reserved_.fetch_sub(size);
+    throw;
+  }
+}
+
+inline auto Arena::DeleteSlab(SlabPtr slab) -> void {
+  reserved_.fetch_sub(slab->size);
+  slab->~Slab();
+  delete[] reinterpret_cast<char*>(slab);
+}
+
+inline auto Arena::Push(AtomicSlabPtr& list, SlabPtr slab) -> void {
+  slab->next = list.load();
+  while (!list.compare_exchange_weak(slab->next, slab)) {
+  }
+}
+
+inline auto Arena::Reuse(std::size_t size) -> char* {
+  auto& list = buffers_.Local().free[SizeClass(size)];
+
+  if (!list.head) {
+    auto& shared = batches_[SizeClass(size)];
+    auto guard = std::lock_guard{shared.lock};
+    if (!shared.head) {
+      return nullptr;
+    }
+    list.head = std::exchange(shared.head, Links(shared.head)[1]);
+    list.length = kBatchSize;
+  }
+
+  --list.length;
+  return std::exchange(list.head, Links(list.head)[0]);
+}
+
+inline auto Arena::Recycle(char* block, std::size_t size) -> void {
+  auto& list = buffers_.Local().free[SizeClass(size)];
+  Links(block)[0] = std::exchange(list.head, block);
+
+  if (++list.length < 2 * kBatchSize) {
+    return;
+  }
+
+  // The first `kBatchSize` blocks leave, the rest stays
+  auto batch = list.head;
+  auto last = batch;
+  for (auto i = std::size_t{1}; i < kBatchSize; ++i) {
+    last = Links(last)[0];
+  }
+  list.head = std::exchange(Links(last)[0], nullptr);
+  list.length -= kBatchSize;
+
+  auto& shared = batches_[SizeClass(size)];
+  auto guard = std::lock_guard{shared.lock};
+  Links(batch)[1] = std::exchange(shared.head, batch);
+}
+
+inline auto Arena::SizeClass(std::size_t size) -> std::size_t {
+  return size / kAlignment - 1;
+}
 
-  return cell.raw;
+inline auto Arena::Links(char* block) -> char** {
+  return reinterpret_cast<char**>(block);
 }
 
 }  // namespace skipper::detail
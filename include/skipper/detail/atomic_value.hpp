@@ -0,0 +1,72 @@
+#ifndef SKIPPER_DETAIL_ATOMIC_VALUE_HPP
+#define SKIPPER_DETAIL_ATOMIC_VALUE_HPP
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace skipper::detail {
+
+template <typename T, typename = void>
+struct IsLockFreeAtomic : std::false_type {};
+
+template <typename T>
+struct IsLockFreeAtomic<T, std::enable_if_t<std::is_trivially_copyable_v<T>>>
+    : std::bool_constant<std::atomic<T>::is_always_lock_free> {};
+
+// Value which may be read and replaced concurrently.
+//
+// Word-sized values are kept in `std::atomic` directly. Other values are
+// boxed: a replacement publishes a new box and retires the previous one,
+// so readers must be pinned while they load.
+//
+// Boxes are managed by the owner, passed as `TBoxes& boxes`, which provides
+//   template <typename... Args> auto NewBox(Args&&... args) -> T*;
+//   auto DeleteBox(T* box) -> void;  // Frees right away
+//   auto RetireBox(T* box) -> void;  // Frees once no reader can observe it
+// so they come from the same allocator as the nodes holding them.
+// `Destroy` has to be called before the value goes away.
+template <typename T, class TBoxes,
+          bool TIsLockFree = IsLockFreeAtomic<T>::value>
+class AtomicValue;
+
+template <typename T, class TBoxes>
+class AtomicValue<T, TBoxes, true> {
+ public:
+  template <typename... Args>
+  explicit AtomicValue(TBoxes& boxes, std::in_place_t, Args&&... args);
+
+  auto Load() const -> T;
+  auto Store(T value, TBoxes& boxes) -> void;
+
+  auto Destroy(TBoxes& boxes) -> void;
+
+ private:
+  std::atomic<T> value_;
+};
+
+template <typename T, class TBoxes>
+class AtomicValue<T, TBoxes, false> {
+ public:
+  template <typename... Args>
+  explicit AtomicValue(TBoxes& boxes, std::in_place_t, Args&&... args);
+
+  AtomicValue(AtomicValue&& other) = delete;
+  AtomicValue(const AtomicValue& other) = delete;
+  AtomicValue& operator=(AtomicValue&& other) = delete;
+  AtomicValue& operator=(const AtomicValue& other) = delete;
+
+  auto Load() const -> T;
+  auto Store(T value, TBoxes& boxes) -> void;
+
+  auto Destroy(TBoxes& boxes) -> void;
+
+ private:
+  std::atomic<T*> box_;
+};
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_ATOMIC_VALUE_HPP
+
+#include "skipper/detail/atomic_value.ipp"
@@ -0,0 +1,60 @@
+#ifndef SKIPPER_DETAIL_ATOMIC_VALUE_IPP
+#define SKIPPER_DETAIL_ATOMIC_VALUE_IPP
+
+#include <utility>
+
+#include "skipper/detail/atomic_value.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, class TBoxes>
+template <typename... Args>
+AtomicValue<T, TBoxes, true>::AtomicValue(TBoxes& /*boxes*/, std::in_place_t,
+                                          Args&&... args)
+    : value_(T(std::forward<Args>(args)...)) {
+}
+
+template <typename T, class TBoxes>
+auto AtomicValue<T, TBoxes, true>::Load() const -> T {
+  return value_.load();
+}
+
+template <typename T, class TBoxes>
+auto AtomicValue<T, TBoxes, true>::Store(T value, TBoxes& /*boxes*/) -> void {
+  value_.store(value);
+}
+
+template <typename T, class TBoxes>
+auto AtomicValue<T, TBoxes, true>::Destroy(TBoxes& /*boxes*/) -> void {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, class TBoxes>
+template <typename... Args>
+AtomicValue<T, TBoxes, false>::AtomicValue(TBoxes& boxes, std::in_place_t,
+                                           Args&&... args)
+    : box_(boxes.NewBox(std::forward<Args>(args)...)) {
+}
+
+template <typename T, class TBoxes>
+auto AtomicValue<T, TBoxes, false>::Load() const -> T {
+  return *box_.load();
+}
+
+template <typename T, class TBoxes>
+auto AtomicValue<T, TBoxes, false>::Store(T value, TBoxes& boxes) -> void {
+  auto box = boxes.NewBox(std::move(value));
+  boxes.RetireBox(box_.exchange(box));
+}
+
+template <typename T, class TBoxes>
+auto AtomicValue<T, TBoxes, false>::Destroy(TBoxes& boxes) -> void {
+  boxes.DeleteBox(box_.load());
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_ATOMIC_VALUE_IPP
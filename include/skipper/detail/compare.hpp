@@ -0,0 +1,26 @@
+#ifndef SKIPPER_DETAIL_COMPARE_HPP
+#define SKIPPER_DETAIL_COMPARE_HPP
+
+#include <type_traits>
+
+namespace skipper::detail {
+
+// Whether `TCompare` orders stored keys of type `T` against lookup keys
+// of type `K`, i.e. either `K` is `T` or `TCompare` declares `is_transparent`
+// (like `std::less<>` does)
+template <typename TCompare, typename K, typename T, typename = void>
+struct IsLookupKey : std::is_same<K, T> {};
+
+template <typename TCompare, typename K, typename T>
+struct IsLookupKey<TCompare, K, T,
+                   std::void_t<typename TCompare::is_transparent>>
+    : std::true_type {};
+
+// Enables heterogeneous overloads of lookup functions
+template <typename TCompare, typename K, typename T>
+using EnableIfLookupKey =
+    std::enable_if_t<IsLookupKey<TCompare, K, T>::value>;
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_COMPARE_HPP
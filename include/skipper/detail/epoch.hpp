@@ -0,0 +1,112 @@
+#ifndef SKIPPER_DETAIL_EPOCH_HPP
+#define SKIPPER_DETAIL_EPOCH_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <vector>
+
+#include "skipper/detail/per_thread.hpp"
+
+namespace skipper::detail {
+
+// Epoch-based memory reclamation.
+//
+// Threads pin the manager for the duration of an operation. Objects unlinked
+// from a shared structure are retired instead of being freed right away:
+// a retired object is tagged with the global epoch and freed only after the
+// epoch has advanced twice, at which point no pinned thread can still
+// observe it. The epoch advances once every pinned thread has announced
+// the current one.
+//
+// Pinning touches only the calling thread's record, so readers never write
+// to memory shared with other threads.
+class EpochManager {
+ private:
+  struct Record;
+
+ public:
+  using Epoch = std::uint64_t;
+  using Deleter = void (*)(void* object, void* context);
+
+  class Guard;
+
+  // Maximum number of threads simultaneously using a single manager
+  static constexpr auto kMaxThreads = PerThread<Record>::kMaxThreads;
+
+ public:
+  EpochManager() = default;
+
+  // Copying and moving is not allowed
+  EpochManager(EpochManager&& other) = delete;
+  EpochManager(const EpochManager& other) = delete;
+  EpochManager& operator=(EpochManager&& other) = delete;
+  EpochManager& operator=(const EpochManager& other) = delete;
+
+  // Frees every retired object, no thread may be pinned at this point
+  ~EpochManager();
+
+  // Enters critical section, pins may be nested
+  auto Pin() -> Guard;
+
+  // Schedules `deleter(object, context)` to be called once no pinned thread
+  // can observe `object`, which must be already unreachable for new readers
+  auto Retire(void* object, Deleter deleter, void* context = nullptr) -> void;
+
+  // Same as above, `object` is freed with `delete`
+  template <typename T>
+  auto Retire(T* object) -> void;
+
+ private:
+  struct Retired {
+    void* object;
+    Deleter deleter;
+    void* context;
+  };
+
+  using RetiredList = std::vector<Retired>;
+
+  // Retired objects are collected after this many retirements per thread
+  static constexpr auto kCollectThreshold = std::size_t{64};
+
+ private:
+  auto Enter(Record& record) -> void;
+  auto Exit(Record& record) -> void;
+
+  auto TryAdvance() -> Epoch;
+  auto Collect(Record& record, Epoch epoch) -> void;
+
+  static auto Free(RetiredList& retired) -> void;
+
+ private:
+  alignas(64) std::atomic<Epoch> epoch_{0};
+  PerThread<Record> records_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class EpochManager::Guard {
+ public:
+  Guard(Guard&& other) = delete;
+  Guard(const Guard& other) = delete;
+  Guard& operator=(Guard&& other) = delete;
+  Guard& operator=(const Guard& other) = delete;
+
+  ~Guard();
+
+ private:
+  friend class EpochManager;
+
+  Guard(EpochManager& manager, Record& record);
+
+ private:
+  EpochManager& manager_;
+  Record& record_;
+};
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_EPOCH_HPP
+
+#include "skipper/detail/epoch.ipp"
@@ -0,0 +1,149 @@
+#ifndef SKIPPER_DETAIL_EPOCH_IPP
+#define SKIPPER_DETAIL_EPOCH_IPP
+
+#include <utility>
+
+#include "skipper/detail/epoch.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Owned by a single thread at a time, only `state` is read by others.
+// Retired objects are kept in three lists, one per epoch modulo 3.
+struct alignas(64) EpochManager::Record {
+ public:
+  static constexpr auto kInactive = Epoch{0};
+
+  static constexpr auto Active(Epoch epoch) -> Epoch {
+    return (epoch << 1) | 1;
+  }
+
+ public:
+  std::atomic<Epoch> state{kInactive};
+  std::size_t depth{0};
+  std::size_t retired_count{0};
+
+  std::array<Epoch, 3> tags{};
+  std::array<RetiredList, 3> limbo{};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline EpochManager::Guard::Guard(EpochManager& manager, Record& record)
+    : manager_(manager), record_(record) {
+  manager_.Enter(record_);
+}
+
+inline EpochManager::Guard::~Guard() {
+  manager_.Exit(record_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline EpochManager::~EpochManager() {
+  records_.ForEach([](Record& record) {
+    for (auto& retired : record.limbo) {
+      Free(retired);
+    }
+  });
+}
+
+inline auto EpochManager::Pin() -> Guard {
+  return Guard{*this, records_.Local()};
+}
+
+inline auto EpochManager::Retire(void* object, Deleter deleter, void* context)
+    -> void {
+  auto& record = records_.Local();
+  auto epoch = epoch_.load();
+  auto slot = static_cast<std::size_t>(epoch % 3);
+
+  // Whatever is left in the slot was retired at least three epochs ago
+  if (record.tags[slot] != epoch) {
+    Free(record.limbo[slot]);
+    record.tags[slot] = epoch;
+  }
+
+  record.limbo[slot].push_back({object, deleter, context});
+
+  if (++record.retired_count >= kCollectThreshold) {
+    record.retired_count = 0;
+    Collect(record, TryAdvance());
+  }
+}
+
+template <typename T>
+auto EpochManager::Retire(T* object) -> void {
+  Retire(object, [](void* retired, void* /*context*/) {
+    delete static_cast<T*>(retired);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Announced epoch is re-checked after being published: otherwise the global
+// epoch might have advanced twice in between and objects retired before
+// the announcement would be freed under the reader's feet.
+inline auto EpochManager::Enter(Record& record) -> void {
+  if (record.depth++ > 0) {
+    return;
+  }
+
+  auto epoch = epoch_.load();
+  while (true) {
+    record.state.store(Record::Active(epoch));
+
+    auto current = epoch_.load();
+    if (current == epoch) {
+      break;
+    }
+
+    epoch = current;
+  }
+}
+
+inline auto EpochManager::Exit(Record& record) -> void {
+  if (--record.depth == 0) {
+    record.state.store(Record::kInactive, std::memory_order_release);
+  }
+}
+
+// Returns the global epoch observed after an attempt to advance it.
+inline auto EpochManager::TryAdvance() -> Epoch {
+  auto epoch = epoch_.load();
+
+  auto announced = true;
+  records_.ForEach([&](Record& record) {
+    auto state = record.state.load();
+    if (state != Record::kInactive && state != Record::Active(epoch)) {
+      announced = false;
+    }
+  });
+
+  if (announced && epoch_.compare_exchange_strong(epoch, epoch + 1)) {
+    return epoch + 1;
+  }
+
+  return epoch;
+}
+
+inline auto EpochManager::Collect(Record& record, Epoch epoch) -> void {
+  for (auto slot = std::size_t{0}; slot < 3; ++slot) {
+    if (record.tags[slot] + 2 <= epoch) {
+      Free(record.limbo[slot]);
+    }
+  }
+}
+
+// Deleters run on a detached list, so they are free to retire more objects
+inline auto EpochManager::Free(RetiredList& retired) -> void {
+  auto detached = std::exchange(retired, RetiredList{});
+  for (auto [object, deleter, context] : detached) {
+    deleter(object, context);
+  }
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_EPOCH_IPP
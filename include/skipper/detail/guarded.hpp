@@ -2,6 +2,8 @@
 #define SKIPPER_DETAIL_GUARDED_HPP
 
 #include <mutex>
+#include <type_traits>
+#include <utility>
 
 namespace skipper::detail {
 
@@ -22,8 +24,17 @@ class Guarded {
  public:
   Guarded() = default;
 
+  // Constructs guarded object from `args`
+  template <typename... Args>
+  explicit Guarded(Args&&... args);
+
   auto operator->() -> Proxy;
 
+  // Runs `action(object)` under a single lock acquisition, e.g. to apply
+  // a whole batch of operations at once
+  template <typename TAction>
+  auto With(TAction&& action) -> std::invoke_result_t<TAction, T&>;
+
  private:
   T object_;
   std::mutex mutex_;
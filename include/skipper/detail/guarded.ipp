@@ -19,11 +19,23 @@ auto Guarded<T>::Proxy::operator->() -> T* {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename T>
+template <typename... Args>
+Guarded<T>::Guarded(Args&&... args) : object_(std::forward<Args>(args)...) {
+}
+
 template <typename T>
 auto Guarded<T>::operator->() -> Proxy {
   return {object_, mutex_};
 }
 
+template <typename T>
+template <typename TAction>
+auto Guarded<T>::With(TAction&& action) -> std::invoke_result_t<TAction, T&> {
+  auto lock = std::unique_lock{mutex_};
+  return std::forward<TAction>(action)(object_);
+}
+
 }  // namespace skipper::detail
 
 #endif  // SKIPPER_DETAIL_GUARDED_IPP
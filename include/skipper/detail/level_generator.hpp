@@ -0,0 +1,44 @@
+#ifndef SKIPPER_DETAIL_LEVEL_GENERATOR_HPP
+#define SKIPPER_DETAIL_LEVEL_GENERATOR_HPP
+
+#include <cstdint>
+
+namespace skipper::detail {
+
+// Level generator policy for skip lists.
+//
+// Levels follow geometric distribution: a node gets promoted to the next
+// level with probability 2^(-TBitsPerLevel). Each level is sampled by counting
+// trailing zeros of a single xorshift draw, so no floating point and no loop
+// over `std::rand()` is involved. State is thread-local, hence concurrent
+// callers never contend with each other.
+template <unsigned TBitsPerLevel = 2>
+class XorShiftLevelGenerator {
+ public:
+  using Level = int;
+  using Probability = double;
+
+  static constexpr auto kProbability =
+      Probability{1.0} / static_cast<Probability>(1u << TBitsPerLevel);
+
+  static_assert(TBitsPerLevel > 0 && TBitsPerLevel < 32,
+                "Bits per level must be in range [1; 32)");
+
+ public:
+  // Returns level in range [0; max_level]
+  static auto Generate(Level max_level) -> Level;
+
+ private:
+  using State = std::uint64_t;
+
+ private:
+  static auto Next() -> State;
+  static auto Seed() -> State;
+  static auto CountTrailingZeros(State value) -> Level;
+};
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_LEVEL_GENERATOR_HPP
+
+#include "skipper/detail/level_generator.ipp"
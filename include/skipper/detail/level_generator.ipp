@@ -0,0 +1,69 @@
+#ifndef SKIPPER_DETAIL_LEVEL_GENERATOR_IPP
+#define SKIPPER_DETAIL_LEVEL_GENERATOR_IPP
+
+#include <algorithm>
+#include <atomic>
+
+#include "skipper/detail/level_generator.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <unsigned TBitsPerLevel>
+auto XorShiftLevelGenerator<TBitsPerLevel>::Generate(Level max_level)
+    -> Level {
+  const auto level = CountTrailingZeros(Next()) / Level{TBitsPerLevel};
+  return std::min(level, max_level);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// xorshift64* (Marsaglia, Vigna)
+template <unsigned TBitsPerLevel>
+auto XorShiftLevelGenerator<TBitsPerLevel>::Next() -> State {
+  thread_local auto state = Seed();
+
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+
+  return state * State{0x2545F4914F6CDD1D};
+}
+
+// Every thread gets its own seed by passing a shared counter through
+// splitmix64. Zero is the only forbidden state for xorshift.
+template <unsigned TBitsPerLevel>
+auto XorShiftLevelGenerator<TBitsPerLevel>::Seed() -> State {
+  static auto counter = std::atomic<State>{0};
+
+  auto z = counter.fetch_add(1, std::memory_order_relaxed) +
+           State{0x9E3779B97F4A7C15};
+  z = (z ^ (z >> 30)) * State{0xBF58476D1CE4E5B9};
+  z = (z ^ (z >> 27)) * State{0x94D049BB133111EB};
+  z = z ^ (z >> 31);
+
+  return z != 0 ? z : State{1};
+}
+
+template <unsigned TBitsPerLevel>
+auto XorShiftLevelGenerator<TBitsPerLevel>::CountTrailingZeros(State value)
+    -> Level {
+  if (value == 0) {
+    return Level{64};
+  }
+
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(value);
+#else
+  auto zeros = Level{0};
+  for (; (value & 1) == 0; value >>= 1) {
+    ++zeros;
+  }
+  return zeros;
+#endif
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_LEVEL_GENERATOR_IPP
@@ -0,0 +1,100 @@
+#ifndef SKIPPER_DETAIL_NODE_ALLOCATOR_HPP
+#define SKIPPER_DETAIL_NODE_ALLOCATOR_HPP
+
+#include <cstddef>  // std::max_align_t, std::size_t
+#include <memory>
+#include <type_traits>
+
+#include "skipper/detail/allocator.hpp"
+
+namespace skipper::detail {
+
+// Allocates raw memory for nodes of a container from `TAllocator`,
+// which is either a standard-conforming allocator of any value type
+// (`std::pmr::polymorphic_allocator` included) or an `Allocator`.
+//
+// Standard allocators are rebound to `std::max_align_t`, so every block is
+// suitably aligned for a node and is allocated as a whole number of units.
+template <class TAllocator, bool = std::is_base_of_v<Allocator, TAllocator>>
+class NodeAllocator {
+ public:
+  // What a container is constructed from
+  using Handle = TAllocator;
+
+ public:
+  explicit NodeAllocator(const Handle& allocator);
+
+  // Throws if memory is exhausted
+  auto Allocate(std::size_t bytes) -> void*;
+  auto Deallocate(void* raw, std::size_t bytes) -> void;
+
+  // Number of bytes `Allocate(bytes)` actually takes from the allocator
+  static auto Footprint(std::size_t bytes) -> std::size_t;
+
+  // Exchanges allocators if they propagate on container swap, otherwise
+  // leaves them in place, so they have to compare equal (as `std::swap`
+  // of standard containers requires)
+  auto Swap(NodeAllocator& other) -> void;
+
+  // Whether a container move-assigned from the one of `other` may take its
+  // nodes over: its allocator either propagates on container move
+  // assignment or compares equal to the one of `other`
+  auto Adopts(const NodeAllocator& other) const -> bool;
+
+  // Hands nodes over after `Adopts(other)`: exchanges allocators if they
+  // propagate on container move assignment or swap
+  auto SwapOnMove(NodeAllocator& other) -> void;
+
+  // Whether memory goes away with this handle. Standard allocators may have
+  // been copied anywhere, so they are never known to be the last one.
+  auto IsSoleOwner() const -> bool;
+
+ private:
+  using Unit = std::max_align_t;
+  using Traits = typename std::allocator_traits<
+      TAllocator>::template rebind_traits<Unit>;
+
+ private:
+  static auto Units(std::size_t bytes) -> std::size_t;
+
+ private:
+  typename Traits::allocator_type allocator_;
+};
+
+// `Allocator` might be shared by several containers, hence it is held
+// by a shared pointer
+template <class TAllocator>
+class NodeAllocator<TAllocator, true> {
+ public:
+  using Handle = std::shared_ptr<TAllocator>;
+
+ public:
+  explicit NodeAllocator(Handle allocator);
+
+  auto Allocate(std::size_t bytes) -> void*;
+  auto Deallocate(void* raw, std::size_t bytes) -> void;
+
+  // Blocks are assumed to be padded to the alignment `Allocator` promises
+  static auto Footprint(std::size_t bytes) -> std::size_t;
+
+  // Allocators are shared, so they always change hands with the nodes
+  auto Swap(NodeAllocator& other) -> void;
+  auto Adopts(const NodeAllocator& other) const -> bool;
+  auto SwapOnMove(NodeAllocator& other) -> void;
+
+  // No other container, nor anyone else, holds the allocator
+  auto IsSoleOwner() const -> bool;
+
+ private:
+  Handle allocator_;
+};
+
+// Returns what a container uses when no allocator is given
+template <class TAllocator>
+auto DefaultAllocator() -> typename NodeAllocator<TAllocator>::Handle;
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_NODE_ALLOCATOR_HPP
+
+#include "skipper/detail/node_allocator.ipp"
@@ -0,0 +1,147 @@
+#ifndef SKIPPER_DETAIL_NODE_ALLOCATOR_IPP
+#define SKIPPER_DETAIL_NODE_ALLOCATOR_IPP
+
+#include <new>
+#include <utility>
+
+#include "skipper/detail/node_allocator.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <class TAllocator, bool TIsAllocator>
+NodeAllocator<TAllocator, TIsAllocator>::NodeAllocator(const Handle& allocator)
+    : allocator_(allocator) {
+}
+
+template <class TAllocator, bool TIsAllocator>
+auto NodeAllocator<TAllocator, TIsAllocator>::Allocate(std::size_t bytes)
+    -> void* {
+  return std::addressof(*Traits::allocate(allocator_, Units(bytes)));
+}
+
+template <class TAllocator, bool TIsAllocator>
+auto NodeAllocator<TAllocator, TIsAllocator>::Deallocate(void* raw,
+                                                         std::size_t bytes)
+    -> void {
+  using Pointer = typename Traits::pointer;
+  using PointerTraits = std::pointer_traits<Pointer>;
+
+  Traits::deallocate(allocator_,
+                     PointerTraits::pointer_to(*static_cast<Unit*>(raw)),
+                     Units(bytes));
+}
+
+template <class TAllocator, bool TIsAllocator>
+auto NodeAllocator<TAllocator, TIsAllocator>::Footprint(std::size_t bytes)
+    -> std::size_t {
+  return Units(bytes) * sizeof(Unit);
+}
+
+template <class TAllocator, bool TIsAllocator>
+auto NodeAllocator<TAllocator, TIsAllocator>::Swap(NodeAllocator& other)
+    -> void {
+  if constexpr (Traits::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(allocator_, other.allocator_);
+  }
+}
+
+template <class TAllocator, bool TIsAllocator>
+auto NodeAllocator<TAllocator, TIsAllocator>::Adopts(
+    const NodeAllocator& other) const -> bool {
+  if constexpr (Traits::propagate_on_container_move_assignment::value ||
+                Traits::is_always_equal::value) {
+    return true;
+  } else {
+    return allocator_ == other.allocator_;
+  }
+}
+
+template <class TAllocator, bool TIsAllocator>
+auto NodeAllocator<TAllocator, TIsAllocator>::SwapOnMove(NodeAllocator& other)
+    -> void {
+  if constexpr (Traits::propagate_on_container_move_assignment::value ||
+                Traits::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(allocator_, other.allocator_);
+  }
+}
+
+template <class TAllocator, bool TIsAllocator>
+auto NodeAllocator<TAllocator, TIsAllocator>::IsSoleOwner() const -> bool {
+  return false;
+}
+
+template <class TAllocator, bool TIsAllocator>
+auto NodeAllocator<TAllocator, TIsAllocator>::Units(std::size_t bytes)
+    -> std::size_t {
+  return (bytes + sizeof(Unit) - 1) / sizeof(Unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <class TAllocator>
+NodeAllocator<TAllocator, true>::NodeAllocator(Handle allocator)
+    : allocator_(std::move(allocator)) {
+}
+
+template <class TAllocator>
+auto NodeAllocator<TAllocator, true>::Allocate(std::size_t bytes) -> void* {
+  if (auto raw = allocator_->Allocate(bytes)) {
+    return raw;
+  }
+
+  throw std::bad_alloc{};
+}
+
+template <class TAllocator>
+auto NodeAllocator<TAllocator, true>::Deallocate(void* raw, std::size_t bytes)
+    -> void {
+  allocator_->Deallocate(static_cast<char*>(raw), bytes);
+}
+
+template <class TAllocator>
+auto NodeAllocator<TAllocator, true>::Footprint(std::size_t bytes)
+    -> std::size_t {
+  constexpr auto kAlignment = alignof(std::max_align_t);
+  return (bytes + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+template <class TAllocator>
+auto NodeAllocator<TAllocator, true>::Swap(NodeAllocator& other) -> void {
+  allocator_.swap(other.allocator_);
+}
+
+template <class TAllocator>
+auto NodeAllocator<TAllocator, true>::Adopts(
+    const NodeAllocator& /*other*/) const -> bool {
+  return true;
+}
+
+template <class TAllocator>
+auto NodeAllocator<TAllocator, true>::SwapOnMove(NodeAllocator& other)
+    -> void {
+  allocator_.swap(other.allocator_);
+}
+
+template <class TAllocator>
+auto NodeAllocator<TAllocator, true>::IsSoleOwner() const -> bool {
+  return allocator_.use_count() == 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <class TAllocator>
+auto DefaultAllocator() -> typename NodeAllocator<TAllocator>::Handle {
+  if constexpr (std::is_base_of_v<Allocator, TAllocator>) {
+    return std::make_shared<TAllocator>();
+  } else {
+    return TAllocator{};
+  }
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_NODE_ALLOCATOR_IPP
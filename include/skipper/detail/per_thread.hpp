@@ -0,0 +1,57 @@
+#ifndef SKIPPER_DETAIL_PER_THREAD_HPP
+#define SKIPPER_DETAIL_PER_THREAD_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>  // std::size_t
+
+namespace skipper::detail {
+
+// Small index of the calling thread, unique among running threads.
+// Indices of exited threads are handed out to new ones.
+auto ThreadIndex() -> std::size_t;
+
+// Instance of `T` per thread, owned by a single object rather than
+// by the thread itself, so it is destroyed together with the owner.
+//
+// Instances are value-initialized in lazily allocated chunks and are
+// indexed by `ThreadIndex()`, so an exited thread's instance is passed on
+// to the next thread which gets its index.
+template <typename T>
+class PerThread {
+ public:
+  // Maximum number of threads simultaneously using a single instance
+  static constexpr auto kMaxThreads = std::size_t{4096};
+
+ public:
+  PerThread() = default;
+
+  // Copying and moving is not allowed
+  PerThread(PerThread&& other) = delete;
+  PerThread(const PerThread& other) = delete;
+  PerThread& operator=(PerThread&& other) = delete;
+  PerThread& operator=(const PerThread& other) = delete;
+
+  ~PerThread();
+
+  // Returns instance of the calling thread
+  auto Local() -> T&;
+
+  // Calls `visitor(T&)` on every instance created so far,
+  // including ones which no thread has accessed yet
+  template <typename TVisitor>
+  auto ForEach(TVisitor&& visitor) -> void;
+
+ private:
+  static constexpr auto kChunkSize = std::size_t{64};
+  static constexpr auto kMaxChunks = kMaxThreads / kChunkSize;
+
+ private:
+  std::array<std::atomic<T*>, kMaxChunks> chunks_{};
+};
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_PER_THREAD_HPP
+
+#include "skipper/detail/per_thread.ipp"
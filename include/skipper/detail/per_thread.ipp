@@ -0,0 +1,95 @@
+#ifndef SKIPPER_DETAIL_PER_THREAD_IPP
+#define SKIPPER_DETAIL_PER_THREAD_IPP
+
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "skipper/detail/per_thread.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline auto ThreadIndex() -> std::size_t {
+  struct Pool {
+    std::mutex lock;
+    std::vector<std::size_t> released;
+    std::size_t next{0};
+  };
+
+  // Never destroyed: threads may exit after static destructors have run
+  static auto& pool = *new Pool{};
+
+  struct Holder {
+    Holder() {
+      auto guard = std::lock_guard{pool.lock};
+      if (pool.released.empty()) {
+        index = pool.next++;
+      } else {
+        index = pool.released.back();
+        pool.released.pop_back();
+      }
+    }
+
+    ~Holder() {
+      auto guard = std::lock_guard{pool.lock};
+      pool.released.push_back(index);
+    }
+
+    std::size_t index{0};
+  };
+
+  thread_local auto holder = Holder{};
+  return holder.index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+PerThread<T>::~PerThread() {
+  for (auto& chunk : chunks_) {
+    delete[] chunk.load();
+  }
+}
+
+template <typename T>
+auto PerThread<T>::Local() -> T& {
+  auto index = ThreadIndex();
+  if (index >= kMaxThreads) {
+    throw std::length_error{"Too many threads use the same object"};
+  }
+
+  auto& chunk = chunks_[index / kChunkSize];
+  auto instances = chunk.load(std::memory_order_acquire);
+
+  if (!instances) {
+    auto fresh = new T[kChunkSize]{};
+    if (chunk.compare_exchange_strong(instances, fresh)) {
+      instances = fresh;
+    } else {
+      delete[] fresh;
+    }
+  }
+
+  return instances[index % kChunkSize];
+}
+
+template <typename T>
+template <typename TVisitor>
+auto PerThread<T>::ForEach(TVisitor&& visitor) -> void {
+  for (auto& chunk : chunks_) {
+    auto instances = chunk.load(std::memory_order_acquire);
+    if (!instances) {
+      continue;
+    }
+
+    for (auto i = std::size_t{0}; i < kChunkSize; ++i) {
+      visitor(instances[i]);
+    }
+  }
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_PER_THREAD_IPP
@@ -0,0 +1,71 @@
+#ifndef SKIPPER_DETAIL_SHARED_GUARDED_HPP
+#define SKIPPER_DETAIL_SHARED_GUARDED_HPP
+
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+
+namespace skipper::detail {
+
+// Same as `Guarded`, but access through a const reference takes
+// the lock in shared mode, so readers do not serialize each other:
+//
+//   std::as_const(guarded)->Find(value);  // Shared
+//   guarded->Insert(value);               // Exclusive
+//
+// Only const member functions are reachable under the shared lock,
+// hence they must not modify the object.
+template <typename T>
+class SharedGuarded {
+ public:
+  class Proxy {
+   public:
+    Proxy(T& object, std::shared_mutex& mutex);
+
+    auto operator->() -> T*;
+
+   private:
+    T& object_;
+    std::unique_lock<std::shared_mutex> lock_;
+  };
+
+  class SharedProxy {
+   public:
+    SharedProxy(const T& object, std::shared_mutex& mutex);
+
+    auto operator->() const -> const T*;
+
+   private:
+    const T& object_;
+    std::shared_lock<std::shared_mutex> lock_;
+  };
+
+ public:
+  SharedGuarded() = default;
+
+  // Constructs guarded object from `args`
+  template <typename... Args>
+  explicit SharedGuarded(Args&&... args);
+
+  auto operator->() -> Proxy;
+  auto operator->() const -> SharedProxy;
+
+  // Run `action(object)` under a single lock acquisition, exclusive
+  // or shared one respectively
+  template <typename TAction>
+  auto With(TAction&& action) -> std::invoke_result_t<TAction, T&>;
+  template <typename TAction>
+  auto WithShared(TAction&& action) const
+      -> std::invoke_result_t<TAction, const T&>;
+
+ private:
+  T object_;
+  mutable std::shared_mutex mutex_;
+};
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_SHARED_GUARDED_HPP
+
+#include "skipper/detail/shared_guarded.ipp"
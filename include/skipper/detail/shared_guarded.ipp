@@ -0,0 +1,69 @@
+#ifndef SKIPPER_DETAIL_SHARED_GUARDED_IPP
+#define SKIPPER_DETAIL_SHARED_GUARDED_IPP
+
+#include "skipper/detail/shared_guarded.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+SharedGuarded<T>::Proxy::Proxy(T& object, std::shared_mutex& mutex)
+    : object_(object), lock_(mutex) {
+}
+
+template <typename T>
+auto SharedGuarded<T>::Proxy::operator->() -> T* {
+  return &object_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+SharedGuarded<T>::SharedProxy::SharedProxy(const T& object,
+                                           std::shared_mutex& mutex)
+    : object_(object), lock_(mutex) {
+}
+
+template <typename T>
+auto SharedGuarded<T>::SharedProxy::operator->() const -> const T* {
+  return &object_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+template <typename... Args>
+SharedGuarded<T>::SharedGuarded(Args&&... args)
+    : object_(std::forward<Args>(args)...) {
+}
+
+template <typename T>
+auto SharedGuarded<T>::operator->() -> Proxy {
+  return {object_, mutex_};
+}
+
+template <typename T>
+auto SharedGuarded<T>::operator->() const -> SharedProxy {
+  return {object_, mutex_};
+}
+
+template <typename T>
+template <typename TAction>
+auto SharedGuarded<T>::With(TAction&& action)
+    -> std::invoke_result_t<TAction, T&> {
+  auto lock = std::unique_lock{mutex_};
+  return std::forward<TAction>(action)(object_);
+}
+
+template <typename T>
+template <typename TAction>
+auto SharedGuarded<T>::WithShared(TAction&& action) const
+    -> std::invoke_result_t<TAction, const T&> {
+  auto lock = std::shared_lock{mutex_};
+  return std::forward<TAction>(action)(object_);
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_SHARED_GUARDED_IPP
@@ -0,0 +1,40 @@
+#ifndef SKIPPER_DETAIL_SPIN_LOCK_HPP
+#define SKIPPER_DETAIL_SPIN_LOCK_HPP
+
+#include <atomic>
+
+namespace skipper::detail {
+
+// Test-and-test-and-set spinlock taking a single byte.
+//
+// Waiters spin on a plain load, so the cache line is not bounced between
+// them until the lock is released, and yield after a while in case the owner
+// is preempted. Not recursive.
+class SpinLock {
+ public:
+  SpinLock() = default;
+
+  // Copying is not allowed
+  SpinLock(const SpinLock& other) = delete;
+  SpinLock& operator=(const SpinLock& other) = delete;
+
+  // Lockable interface, so `std::unique_lock` works
+  auto lock() -> void;
+  auto try_lock() -> bool;
+  auto unlock() -> void;
+
+ private:
+  static constexpr auto kSpinsBeforeYield = 64;
+
+ private:
+  static auto Pause() -> void;
+
+ private:
+  std::atomic<bool> locked_{false};
+};
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_SPIN_LOCK_HPP
+
+#include "skipper/detail/spin_lock.ipp"
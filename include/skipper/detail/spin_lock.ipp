@@ -0,0 +1,45 @@
+#ifndef SKIPPER_DETAIL_SPIN_LOCK_IPP
+#define SKIPPER_DETAIL_SPIN_LOCK_IPP
+
+#include <thread>
+
+#include "skipper/detail/spin_lock.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline auto SpinLock::lock() -> void {
+  while (locked_.exchange(true, std::memory_order_acquire)) {
+    for (auto spins = 0; locked_.load(std::memory_order_relaxed); ++spins) {
+      if (spins < kSpinsBeforeYield) {
+        Pause();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
+inline auto SpinLock::try_lock() -> bool {
+  return !locked_.load(std::memory_order_relaxed) &&
+         !locked_.exchange(true, std::memory_order_acquire);
+}
+
+inline auto SpinLock::unlock() -> void {
+  locked_.store(false, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline auto SpinLock::Pause() -> void {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_SPIN_LOCK_IPP
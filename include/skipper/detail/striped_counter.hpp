@@ -0,0 +1,38 @@
+#ifndef SKIPPER_DETAIL_STRIPED_COUNTER_HPP
+#define SKIPPER_DETAIL_STRIPED_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>  // std::ptrdiff_t
+
+#include "skipper/detail/per_thread.hpp"
+
+namespace skipper::detail {
+
+// Counter which is updated by many threads at once and read rarely.
+//
+// Every thread adds to a stripe of its own, so updates never contend for
+// a cache line, and a read sums all stripes up. The sum is exact once
+// concurrent updates are over, while they run it may be off by them.
+class StripedCounter {
+ public:
+  StripedCounter() = default;
+
+  // Copying is not allowed
+  StripedCounter(const StripedCounter& other) = delete;
+  StripedCounter& operator=(const StripedCounter& other) = delete;
+
+  auto Add(std::ptrdiff_t delta) -> void;
+  auto Load() -> std::ptrdiff_t;
+
+ private:
+  struct Stripe;
+
+ private:
+  PerThread<Stripe> stripes_;
+};
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_STRIPED_COUNTER_HPP
+
+#include "skipper/detail/striped_counter.ipp"
@@ -0,0 +1,35 @@
+#ifndef SKIPPER_DETAIL_STRIPED_COUNTER_IPP
+#define SKIPPER_DETAIL_STRIPED_COUNTER_IPP
+
+#include "skipper/detail/striped_counter.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Written by a single thread only, hence aligned to avoid false sharing
+struct alignas(64) StripedCounter::Stripe {
+  std::atomic<std::ptrdiff_t> value{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// The owner is the only writer of its stripe, so a plain load and store
+// do instead of a read-modify-write. Atomics only keep readers race-free.
+inline auto StripedCounter::Add(std::ptrdiff_t delta) -> void {
+  auto& value = stripes_.Local().value;
+  value.store(value.load(std::memory_order_relaxed) + delta,
+              std::memory_order_relaxed);
+}
+
+inline auto StripedCounter::Load() -> std::ptrdiff_t {
+  auto sum = std::ptrdiff_t{0};
+  stripes_.ForEach([&](Stripe& stripe) {
+    sum += stripe.value.load(std::memory_order_relaxed);
+  });
+  return sum;
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_STRIPED_COUNTER_IPP
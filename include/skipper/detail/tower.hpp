@@ -0,0 +1,46 @@
+#ifndef SKIPPER_DETAIL_TOWER_HPP
+#define SKIPPER_DETAIL_TOWER_HPP
+
+#include <cstddef>  // std::size_t
+
+namespace skipper::detail {
+
+// Layout of a skip list node which keeps its forward links right after itself,
+// so a node and its tower share a single allocation:
+//
+// ┌–––––––┬––––––––┬––––––––┬–––––┬––––––––––––┐
+// | TNode | TLink0 | TLink1 | ... | TLinkLevel |
+// └–––––––┴––––––––┴––––––––┴–––––┴––––––––––––┘
+//
+// Links are reached by an offset from the node itself instead of
+// dereferencing a separately allocated array.
+template <typename TNode, typename TLink>
+class Tower {
+ public:
+  using Level = int;
+
+ public:
+  // Number of bytes required for a node with links on levels [0; level]
+  static constexpr auto AllocationSize(Level level) -> std::size_t;
+
+  // Constructs node and all of its links in `raw`,
+  // which must be at least `AllocationSize(level)` bytes long
+  template <typename... Args>
+  static auto Construct(void* raw, Level level, Args&&... args) -> TNode*;
+
+  // Destroys node and all of its links without releasing memory
+  static auto Destroy(TNode* node, Level level) -> void;
+
+  static auto Links(TNode* node) -> TLink*;
+  static auto Links(const TNode* node) -> const TLink*;
+
+ private:
+  static constexpr auto kLinksOffset =
+      (sizeof(TNode) + alignof(TLink) - 1) / alignof(TLink) * alignof(TLink);
+};
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_TOWER_HPP
+
+#include "skipper/detail/tower.ipp"
@@ -0,0 +1,56 @@
+#ifndef SKIPPER_DETAIL_TOWER_IPP
+#define SKIPPER_DETAIL_TOWER_IPP
+
+#include <new>
+#include <utility>
+
+#include "skipper/detail/tower.hpp"
+
+namespace skipper::detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TNode, typename TLink>
+constexpr auto Tower<TNode, TLink>::AllocationSize(Level level)
+    -> std::size_t {
+  return kLinksOffset + (static_cast<std::size_t>(level) + 1) * sizeof(TLink);
+}
+
+template <typename TNode, typename TLink>
+template <typename... Args>
+auto Tower<TNode, TLink>::Construct(void* raw, Level level, Args&&... args)
+    -> TNode* {
+  auto node = new (raw) TNode(std::forward<Args>(args)...);
+
+  auto bytes = static_cast<unsigned char*>(raw) + kLinksOffset;
+  for (auto i = Level{0}; i <= level; ++i) {
+    new (bytes + static_cast<std::size_t>(i) * sizeof(TLink)) TLink{};
+  }
+
+  return node;
+}
+
+template <typename TNode, typename TLink>
+auto Tower<TNode, TLink>::Destroy(TNode* node, Level level) -> void {
+  auto links = Links(node);
+  for (auto i = Level{0}; i <= level; ++i) {
+    links[i].~TLink();
+  }
+  node->~TNode();
+}
+
+template <typename TNode, typename TLink>
+auto Tower<TNode, TLink>::Links(TNode* node) -> TLink* {
+  auto bytes = reinterpret_cast<unsigned char*>(node) + kLinksOffset;
+  return std::launder(reinterpret_cast<TLink*>(bytes));
+}
+
+template <typename TNode, typename TLink>
+auto Tower<TNode, TLink>::Links(const TNode* node) -> const TLink* {
+  auto bytes = reinterpret_cast<const unsigned char*>(node) + kLinksOffset;
+  return std::launder(reinterpret_cast<const TLink*>(bytes));
+}
+
+}  // namespace skipper::detail
+
+#endif  // SKIPPER_DETAIL_TOWER_IPP
@@ -1,13 +1,29 @@
 #ifndef SKIPPER_GUARDED_MAP_HPP
 #define SKIPPER_GUARDED_MAP_HPP
 
+#include <functional>
+#include <memory>
+#include <utility>
+
 #include "skipper/sequential_map.hpp"
 #include "skipper/detail/guarded.hpp"
+#include "skipper/detail/shared_guarded.hpp"
 
 namespace skipper {
 
-template <typename Key, typename Value>
-using GuardedSkipListMap = detail::Guarded<SequentialSkipListMap<Key, Value>>;
+template <typename Key, typename Value, int TMaxLevel = 4,
+          class TLevelGenerator = detail::XorShiftLevelGenerator<>,
+          class TAllocator = std::allocator<std::pair<const Key, Value>>,
+          class TCompare = std::less<Key>>
+using GuardedSkipListMap = detail::Guarded<SequentialSkipListMap<
+    Key, Value, TMaxLevel, TLevelGenerator, TAllocator, TCompare>>;
+
+template <typename Key, typename Value, int TMaxLevel = 4,
+          class TLevelGenerator = detail::XorShiftLevelGenerator<>,
+          class TAllocator = std::allocator<std::pair<const Key, Value>>,
+          class TCompare = std::less<Key>>
+using SharedGuardedSkipListMap = detail::SharedGuarded<SequentialSkipListMap<
+    Key, Value, TMaxLevel, TLevelGenerator, TAllocator, TCompare>>;
 
 }
 
@@ -1,13 +1,27 @@
 #ifndef SKIPPER_GUARDED_SET_HPP
 #define SKIPPER_GUARDED_SET_HPP
 
+#include <functional>
+#include <memory>
+
 #include "skipper/sequential_set.hpp"
 #include "skipper/detail/guarded.hpp"
+#include "skipper/detail/shared_guarded.hpp"
 
 namespace skipper {
 
-template <typename T>
-using GuardedSkipListSet = detail::Guarded<SequentialSkipListSet<T>>;
+template <typename T, int TMaxLevel = 4,
+          class TLevelGenerator = detail::XorShiftLevelGenerator<>,
+          class TAllocator = std::allocator<T>, class TCompare = std::less<T>>
+using GuardedSkipListSet = detail::Guarded<SequentialSkipListSet<
+    T, TMaxLevel, TLevelGenerator, TAllocator, TCompare>>;
+
+// Lets `Find` and iteration through a const reference run in parallel
+template <typename T, int TMaxLevel = 4,
+          class TLevelGenerator = detail::XorShiftLevelGenerator<>,
+          class TAllocator = std::allocator<T>, class TCompare = std::less<T>>
+using SharedGuardedSkipListSet = detail::SharedGuarded<SequentialSkipListSet<
+    T, TMaxLevel, TLevelGenerator, TAllocator, TCompare>>;
 
 }
 
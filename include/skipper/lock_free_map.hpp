@@ -0,0 +1,154 @@
+#ifndef SKIPPER_LOCK_FREE_MAP_HPP
+#define SKIPPER_LOCK_FREE_MAP_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "skipper/detail/arena.hpp"
+#include "skipper/detail/atomic_value.hpp"
+#include "skipper/detail/compare.hpp"
+#include "skipper/detail/epoch.hpp"
+#include "skipper/detail/level_generator.hpp"
+#include "skipper/detail/node_allocator.hpp"
+#include "skipper/detail/striped_counter.hpp"
+#include "skipper/detail/tower.hpp"
+
+namespace skipper {
+
+// Keys are ordered by `TCompare`, see `SequentialSkipListSet`.
+//
+// Nodes and boxed values come from an `Arena` by default, which keeps all
+// of its memory until destroyed, see `LockFreeSkipListSet`.
+template <typename Key, typename Value,
+          class TAllocator = skipper::detail::Arena, int TMaxLevel = 4,
+          class TLevelGenerator = skipper::detail::XorShiftLevelGenerator<>,
+          class TCompare = std::less<Key>>
+class LockFreeSkipListMap {
+ private:
+  struct Node;
+
+ public:
+  using Level = int;
+  using Probability = double;
+
+  static constexpr auto kMaxLevel = Level{TMaxLevel};
+  static constexpr auto kProbability = TLevelGenerator::kProbability;
+
+  static_assert(kMaxLevel >= 0, "Maximum level must be non-negative");
+
+  using AllocatorHandle = typename detail::NodeAllocator<TAllocator>::Handle;
+
+ public:
+  LockFreeSkipListMap();
+
+  // Nodes are allocated from `allocator`, which might be shared with
+  // other containers. Insertion throws if it runs out of memory.
+  explicit LockFreeSkipListMap(const AllocatorHandle& allocator);
+
+  LockFreeSkipListMap(LockFreeSkipListMap&& other) = delete;
+  LockFreeSkipListMap(const LockFreeSkipListMap& other) = delete;
+  LockFreeSkipListMap& operator=(LockFreeSkipListMap&& other) = delete;
+  LockFreeSkipListMap& operator=(const LockFreeSkipListMap& other) = delete;
+
+  ~LockFreeSkipListMap();
+
+  auto Contains(const Key& key) -> bool;
+  auto Get(const Key& key) -> std::optional<Value>;
+
+  // Returns `true` if the key was inserted and `false` if it was present
+  auto Insert(const Key& key, const Value& value) -> bool;
+  auto InsertOrAssign(const Key& key, const Value& value) -> bool;
+
+  auto Erase(const Key& key) -> bool;
+
+  // Both move into a new node, which is allocated before it is linked.
+  // If another thread inserts the key in the meantime, `false` is returned
+  // and the arguments may still be moved from.
+  auto Insert(Key&& key, Value&& value) -> bool;
+  template <typename... Args>
+  auto TryEmplace(const Key& key, Args&&... args) -> bool;
+  template <typename... Args>
+  auto TryEmplace(Key&& key, Args&&... args) -> bool;
+
+  // Heterogeneous lookups, available with a transparent `TCompare` only
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, Key>>
+  auto Contains(const K& key) -> bool;
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, Key>>
+  auto Erase(const K& key) -> bool;
+
+  // See `LockFreeSkipListSet`. Values which are not lock-free atomics
+  // are boxed, boxes are taken from `TAllocator` and counted as well.
+  auto Size() -> std::size_t;
+  auto Empty() -> bool;
+  auto MemoryUsage() -> std::size_t;
+
+  // Calls `visitor(const Key&, const Value&)` on keys within [`lo`, `hi`)
+  // in ascending order, passing a copy of the value taken at the visit.
+  // Keys inserted or erased during the scan may or may not be visited.
+  template <typename TVisitor>
+  auto ForEachInRange(const Key& lo, const Key& hi, TVisitor&& visitor)
+      -> void;
+
+ private:
+  using Counter = std::atomic<int>;
+  using NodePtr = Node*;
+  using NodePtrList =
+      std::array<NodePtr, static_cast<std::size_t>(kMaxLevel) + 1>;
+  using AtomicNodePtr = std::atomic<NodePtr>;
+  using AtomicValue = detail::AtomicValue<Value, LockFreeSkipListMap>;
+
+  // Provides boxes to `AtomicValue`
+  friend AtomicValue;
+
+ private:
+  struct FindResult;
+
+ private:
+  template <typename TKey, typename... Args>
+  auto Upsert(bool assign, TKey&& key, Args&&... args) -> bool;
+
+  template <typename TKey, typename... Args>
+  auto New(Level level, TKey&& key, Args&&... args) -> NodePtr;
+  auto Delete(NodePtr node) -> void;
+  auto Release(NodePtr node) -> void;
+
+  template <typename... Args>
+  auto NewBox(Args&&... args) -> Value*;
+  auto DeleteBox(Value* box) -> void;
+  auto RetireBox(Value* box) -> void;
+
+  template <typename K>
+  auto Find(const K& key) -> FindResult;
+  template <typename K>
+  auto FindNode(const K& key) -> NodePtr;
+  template <typename K>
+  auto Seek(const K& key) -> NodePtr;
+  auto GenerateRandomLevel() -> Level;
+
+  static auto IsMarked(NodePtr node) -> bool;
+  static auto Marked(NodePtr node) -> NodePtr;
+  static auto Unmarked(NodePtr node) -> NodePtr;
+
+ private:
+  using Tower = detail::Tower<Node, AtomicNodePtr>;
+
+ private:
+  detail::NodeAllocator<TAllocator> allocator_;
+  TCompare compare_{};
+  detail::StripedCounter size_;
+  detail::StripedCounter memory_;
+  NodePtr head_{New(kMaxLevel, Key{})};
+  NodePtr tail_{New(kMaxLevel, Key{})};
+
+  detail::EpochManager epochs_;
+};
+
+}  // namespace skipper
+
+#endif  // SKIPPER_LOCK_FREE_MAP_HPP
+
+#include "skipper/lock_free_map.ipp"
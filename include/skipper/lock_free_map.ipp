@@ -0,0 +1,566 @@
+#ifndef SKIPPER_LOCK_FREE_MAP_IPP
+#define SKIPPER_LOCK_FREE_MAP_IPP
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include "skipper/lock_free_map.hpp"
+
+namespace skipper {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+struct LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                           TCompare>::Node {
+ public:
+  template <typename TKey, typename... Args>
+  Node(Level l, LockFreeSkipListMap& map, TKey&& k, Args&&... args);
+
+  auto Forward(std::size_t i) -> AtomicNodePtr&;
+
+ public:
+  Key key;
+  AtomicValue value;
+  Level level;
+
+  // See `LockFreeSkipListSet::Node`
+  Counter references{2};
+};
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename TKey, typename... Args>
+LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                    TCompare>::Node::Node(Level l, LockFreeSkipListMap& map,
+                                          TKey&& k, Args&&... args)
+    : key(std::forward<TKey>(k)),
+      value(map, std::in_place, std::forward<Args>(args)...),
+      level(l) {
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Node::Forward(std::size_t i)
+    -> AtomicNodePtr& {
+  return Tower::Links(this)[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+struct LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                           TCompare>::FindResult {
+  bool found;
+  NodePtrList predecessors{};
+  NodePtrList successors{};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                    TCompare>::LockFreeSkipListMap()
+    : LockFreeSkipListMap(detail::DefaultAllocator<TAllocator>()) {
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                    TCompare>::
+    LockFreeSkipListMap(const AllocatorHandle& allocator)
+    : allocator_(allocator) {
+  for (auto level = 0; level <= kMaxLevel; ++level) {
+    head_->Forward(static_cast<std::size_t>(level)).store(tail_);
+  }
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                    TCompare>::~LockFreeSkipListMap() {
+  for (auto node = head_; node;) {
+    auto next = Unmarked(node->Forward(0).load());
+    Delete(node);
+    node = next;
+  }
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Contains(const Key& key) -> bool {
+  return Contains<Key>(key);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename K, typename>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Contains(const K& key) -> bool {
+  auto epoch_guard = epochs_.Pin();
+  return FindNode(key) != nullptr;
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Get(const Key& key)
+    -> std::optional<Value> {
+  auto epoch_guard = epochs_.Pin();
+
+  if (auto node = FindNode(key)) {
+    return node->value.Load();
+  } else {
+    return std::nullopt;
+  }
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Insert(
+    const Key& key, const Value& value) -> bool {
+  return Upsert(/*assign=*/false, key, value);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Insert(Key&& key, Value&& value)
+    -> bool {
+  return Upsert(/*assign=*/false, std::move(key), std::move(value));
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename... Args>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::TryEmplace(const Key& key,
+                                                      Args&&... args) -> bool {
+  return Upsert(/*assign=*/false, key, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename... Args>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::TryEmplace(Key&& key, Args&&... args)
+    -> bool {
+  return Upsert(/*assign=*/false, std::move(key), std::forward<Args>(args)...);
+}
+
+// Replaces the value in place if the key is present. Assignment to a node
+// which has been erased in the meantime is lost, so it is retried then.
+//
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::InsertOrAssign(
+    const Key& key, const Value& value) -> bool {
+  return Upsert(/*assign=*/true, key, value);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Erase(const Key& key) -> bool {
+  return Erase<Key>(key);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename K, typename>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Erase(const K& key) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
+  auto [found, predecessors, successors] = Find(key);
+  if (!found) {
+    return false;
+  }
+
+  auto node = successors[0];
+
+  for (auto level = node->level; level > 0; --level) {
+    auto& forward = node->Forward(static_cast<std::size_t>(level));
+    auto succ = forward.load();
+    while (!IsMarked(succ) &&
+           !forward.compare_exchange_weak(succ, Marked(succ))) {
+    }
+  }
+
+  auto& forward = node->Forward(0);
+  auto succ = forward.load();
+
+  while (!IsMarked(succ)) {
+    if (forward.compare_exchange_strong(succ, Marked(succ))) {
+      size_.Add(-1);
+      Find(key);
+      Release(node);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Size() -> std::size_t {
+  return static_cast<std::size_t>(std::max(size_.Load(), std::ptrdiff_t{0}));
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Empty() -> bool {
+  return Size() == 0;
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::MemoryUsage() -> std::size_t {
+  return static_cast<std::size_t>(
+      std::max(memory_.Load(), std::ptrdiff_t{0}));
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename TVisitor>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::ForEachInRange(
+    const Key& lo, const Key& hi, TVisitor&& visitor) -> void {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node = Seek(lo);
+  while (node != tail_ && compare_(node->key, hi)) {
+    auto next = node->Forward(0).load();
+    if (!IsMarked(next)) {
+      visitor(std::as_const(node->key), node->value.Load());
+    }
+    node = Unmarked(next);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Same scheme as `LockFreeSkipListSet::Insert`. Only `InsertOrAssign`
+// passes `assign`, and its arguments are const references, so forwarding
+// them on every retry is safe.
+//
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename TKey, typename... Args>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Upsert(bool assign, TKey&& key,
+                                                  Args&&... args) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node_level = GenerateRandomLevel();
+  auto node = NodePtr{};
+  auto lookup = &std::as_const(key);
+
+  while (true) {
+    auto [found, predecessors, successors] = Find(*lookup);
+    if (found) {
+      if (!assign) {
+        if (node) {
+          Delete(node);
+        }
+        return false;
+      }
+
+      auto existing = successors[0];
+      existing->value.Store(Value(std::forward<Args>(args)...), *this);
+      if (IsMarked(existing->Forward(0).load())) {
+        continue;
+      }
+
+      if (node) {
+        Delete(node);
+      }
+      return false;
+    }
+
+    if (!node) {
+      node = New(node_level, std::forward<TKey>(key),
+                 std::forward<Args>(args)...);
+      lookup = &node->key;
+    }
+
+    for (auto level = 0; level <= node_level; ++level) {
+      auto i = static_cast<std::size_t>(level);
+      node->Forward(i).store(successors[i]);
+    }
+
+    auto pred = predecessors[0];
+    auto succ = successors[0];
+
+    if (!pred->Forward(0).compare_exchange_strong(succ, node)) {
+      continue;
+    }
+    size_.Add(1);
+
+    auto is_erased = false;
+
+    for (auto level = 1; !is_erased && level <= node_level; ++level) {
+      auto i = static_cast<std::size_t>(level);
+
+      while (true) {
+        pred = predecessors[i];
+        succ = successors[i];
+
+        auto next = node->Forward(i).load();
+        if (next != succ && !IsMarked(next)) {
+          node->Forward(i).compare_exchange_strong(next, succ);
+        }
+
+        if (IsMarked(next)) {
+          is_erased = true;
+          break;
+        }
+
+        if (pred->Forward(i).compare_exchange_strong(succ, node)) {
+          break;
+        }
+
+        auto res = Find(*lookup);
+        predecessors = std::move(res.predecessors);
+        successors = std::move(res.successors);
+      }
+    }
+
+    if (is_erased || IsMarked(node->Forward(0).load())) {
+      Find(*lookup);
+    }
+
+    Release(node);
+
+    return true;
+  }
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename TKey, typename... Args>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::New(Level level, TKey&& key,
+                                               Args&&... args)
+    -> LockFreeSkipListMap::NodePtr {
+  auto size = Tower::AllocationSize(level);
+  auto raw = allocator_.Allocate(size);
+  try {
+    auto node =
+        Tower::Construct(raw, level, level, *this, std::forward<TKey>(key),
+                         std::forward<Args>(args)...);
+    memory_.Add(static_cast<std::ptrdiff_t>(allocator_.Footprint(size)));
+    return node;
+  } catch (...) {
+    allocator_.Deallocate(raw, size);
+    throw;
+  }
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Delete(NodePtr node) -> void {
+  auto level = node->level;
+  auto size = Tower::AllocationSize(level);
+  node->value.Destroy(*this);
+  Tower::Destroy(node, level);
+  allocator_.Deallocate(node, size);
+  memory_.Add(-static_cast<std::ptrdiff_t>(allocator_.Footprint(size)));
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Release(NodePtr node) -> void {
+  if (node->references.fetch_sub(1) != 1) {
+    return;
+  }
+
+  epochs_.Retire(
+      node,
+      [](void* retired, void* map) {
+        static_cast<LockFreeSkipListMap*>(map)->Delete(
+            static_cast<NodePtr>(retired));
+      },
+      this);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename... Args>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::NewBox(Args&&... args) -> Value* {
+  auto raw = allocator_.Allocate(sizeof(Value));
+  try {
+    auto box = new (raw) Value(std::forward<Args>(args)...);
+    memory_.Add(
+        static_cast<std::ptrdiff_t>(allocator_.Footprint(sizeof(Value))));
+    return box;
+  } catch (...) {
+    allocator_.Deallocate(raw, sizeof(Value));
+    throw;
+  }
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::DeleteBox(Value* box) -> void {
+  box->~Value();
+  allocator_.Deallocate(box, sizeof(Value));
+  memory_.Add(
+      -static_cast<std::ptrdiff_t>(allocator_.Footprint(sizeof(Value))));
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::RetireBox(Value* box) -> void {
+  epochs_.Retire(
+      box,
+      [](void* retired, void* map) {
+        static_cast<LockFreeSkipListMap*>(map)->DeleteBox(
+            static_cast<Value*>(retired));
+      },
+      this);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename K>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Find(const K& key)
+    -> LockFreeSkipListMap::FindResult {
+  auto result = FindResult{};
+
+retry:
+  while (true) {
+    auto pred = head_;
+    auto curr = NodePtr{};
+
+    for (auto level = kMaxLevel; level >= 0; --level) {
+      auto i = static_cast<std::size_t>(level);
+
+      curr = Unmarked(pred->Forward(i).load());
+      while (true) {
+        auto succ = curr->Forward(i).load();
+
+        while (IsMarked(succ)) {
+          succ = Unmarked(succ);
+          if (!pred->Forward(i).compare_exchange_strong(curr, succ)) {
+            goto retry;
+          }
+
+          curr = succ;
+          succ = curr->Forward(i).load();
+        }
+
+        if (curr != tail_ && compare_(curr->key, key)) {
+          pred = std::exchange(curr, succ);
+        } else {
+          break;
+        }
+      }
+
+      result.predecessors[i] = pred;
+      result.successors[i] = curr;
+    }
+
+    result.found = curr != tail_ && !compare_(key, curr->key);
+    return result;
+  }
+}
+
+// Read-only counterpart of `Find`, returns `nullptr` if there is no such key
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename K>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::FindNode(const K& key)
+    -> LockFreeSkipListMap::NodePtr {
+  if (auto node = Seek(key); node != tail_ && !compare_(key, node->key)) {
+    return node;
+  } else {
+    return nullptr;
+  }
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+template <typename K>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Seek(const K& key)
+    -> LockFreeSkipListMap::NodePtr {
+  auto pred = head_;
+  auto curr = NodePtr{};
+
+  for (auto level = kMaxLevel; level >= 0; --level) {
+    auto i = static_cast<std::size_t>(level);
+
+    curr = Unmarked(pred->Forward(i).load());
+    while (true) {
+      auto succ = curr->Forward(i).load();
+      while (IsMarked(succ)) {
+        curr = Unmarked(succ);
+        succ = curr->Forward(i).load();
+      }
+
+      if (curr != tail_ && compare_(curr->key, key)) {
+        pred = std::exchange(curr, succ);
+      } else {
+        break;
+      }
+    }
+  }
+
+  return curr;
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::GenerateRandomLevel()
+    -> LockFreeSkipListMap::Level {
+  return TLevelGenerator::Generate(kMaxLevel);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::IsMarked(NodePtr node) -> bool {
+  return (reinterpret_cast<std::uintptr_t>(node) & 1) != 0;
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Marked(NodePtr node)
+    -> LockFreeSkipListMap::NodePtr {
+  return reinterpret_cast<NodePtr>(reinterpret_cast<std::uintptr_t>(node) | 1);
+}
+
+template <typename Key, typename Value, class TAllocator, int TMaxLevel,
+          class TLevelGenerator, class TCompare>
+auto LockFreeSkipListMap<Key, Value, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Unmarked(NodePtr node)
+    -> LockFreeSkipListMap::NodePtr {
+  auto bits = reinterpret_cast<std::uintptr_t>(node);
+  return reinterpret_cast<NodePtr>(bits & ~std::uintptr_t{1});
+}
+
+}  // namespace skipper
+
+#endif  // SKIPPER_LOCK_FREE_MAP_IPP
@@ -1,16 +1,31 @@
 #ifndef SKIPPER_LOCK_FREE_SET_HPP
 #define SKIPPER_LOCK_FREE_SET_HPP
 
+#include <array>
 #include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <vector>
 
-#include "skipper/detail/allocator.hpp"
 #include "skipper/detail/arena.hpp"
+#include "skipper/detail/compare.hpp"
+#include "skipper/detail/epoch.hpp"
+#include "skipper/detail/level_generator.hpp"
+#include "skipper/detail/node_allocator.hpp"
+#include "skipper/detail/striped_counter.hpp"
+#include "skipper/detail/tower.hpp"
 
 namespace skipper {
 
-template <typename T, class TAllocator = skipper::detail::Arena>
+// Values are ordered by `TCompare`, see `SequentialSkipListSet`.
+//
+// Nodes come from an `Arena` by default. It reuses memory of freed nodes
+// for new ones, but returns nothing to the system before it is destroyed,
+// so the memory held is that of the largest size the set has reached.
+template <typename T, class TAllocator = skipper::detail::Arena,
+          int TMaxLevel = 4,
+          class TLevelGenerator = skipper::detail::XorShiftLevelGenerator<>,
+          class TCompare = std::less<T>>
 class LockFreeSkipListSet {
  private:
   struct Node;
@@ -19,40 +34,104 @@ class LockFreeSkipListSet {
   using Level = int;
   using Probability = double;
 
-  static constexpr auto kMaxLevel = Level{4};
-  static constexpr auto kProbability = Probability{0.2};
+  static constexpr auto kMaxLevel = Level{TMaxLevel};
+  static constexpr auto kProbability = TLevelGenerator::kProbability;
+
+  static_assert(kMaxLevel >= 0, "Maximum level must be non-negative");
+
+  using AllocatorHandle = typename detail::NodeAllocator<TAllocator>::Handle;
 
  public:
   LockFreeSkipListSet();
 
+  // Nodes are allocated from `allocator`, which might be shared with
+  // other containers. Insertion throws if it runs out of memory.
+  explicit LockFreeSkipListSet(const AllocatorHandle& allocator);
+
   LockFreeSkipListSet(LockFreeSkipListSet&& other) = delete;
   LockFreeSkipListSet(const LockFreeSkipListSet& other) = delete;
   LockFreeSkipListSet& operator=(LockFreeSkipListSet&& other) = delete;
   LockFreeSkipListSet& operator=(const LockFreeSkipListSet& other) = delete;
 
+  ~LockFreeSkipListSet();
+
   auto Contains(const T& value) -> bool;
   auto Insert(const T& value) -> bool;
+  auto Erase(const T& value) -> bool;
+
+  // Both move the value into a new node. The node is allocated before it
+  // is linked, so an equal value inserted by another thread in the meantime
+  // may leave the argument moved from even though `false` is returned.
+  auto Insert(T&& value) -> bool;
+  template <typename... Args>
+  auto Emplace(Args&&... args) -> bool;
+
+  // Heterogeneous lookups, available with a transparent `TCompare` only
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, T>>
+  auto Contains(const K& key) -> bool;
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, T>>
+  auto Erase(const K& key) -> bool;
+
+  // Same as in `ConcurrentSkipListSet`. Memory of freed nodes stays in
+  // an `Arena`, `Arena::Reserved` tells what it holds.
+  auto Size() -> std::size_t;
+  auto Empty() -> bool;
+  auto MemoryUsage() -> std::size_t;
+
+  // Calls `visitor(const T&)` on values within [`lo`, `hi`) in ascending
+  // order. Values inserted or erased during the scan may or may not be
+  // visited.
+  template <typename TVisitor>
+  auto ForEachInRange(const T& lo, const T& hi, TVisitor&& visitor) -> void;
 
  private:
-  using Allocator = skipper::detail::Allocator;
-  using AllocatorPtr = std::shared_ptr<Allocator>;
-
-  using Flag = std::atomic<bool>;
-  using NodePtr = std::atomic<Node*>;
-  using NodePtrList = std::vector<NodePtr>;
+  using Counter = std::atomic<int>;
+  using NodePtr = Node*;
+  using NodePtrList =
+      std::array<NodePtr, static_cast<std::size_t>(kMaxLevel) + 1>;
+  using AtomicNodePtr = std::atomic<NodePtr>;
 
  private:
   struct FindResult;
 
  private:
-  auto New(const T& value, Level level) -> Node*;
-  auto Find(const T& value) -> FindResult;
+  template <typename TValue>
+  auto InsertValue(TValue&& value) -> bool;
+
+  template <typename... Args>
+  auto New(Level level, Args&&... args) -> NodePtr;
+  auto Delete(NodePtr node) -> void;
+
+  // Drops one of the two references held by inserting and erasing threads,
+  // the last one retires the node
+  auto Release(NodePtr node) -> void;
+
+  template <typename K>
+  auto Find(const K& key) -> FindResult;
+  // Returns the first node not less than `key` which was not erased
+  // when visited, without unlinking erased nodes on the way
+  template <typename K>
+  auto Seek(const K& key) -> NodePtr;
   auto GenerateRandomLevel() -> Level;
 
+  // The lowest bit of a forward link marks its owner as erased
+  static auto IsMarked(NodePtr node) -> bool;
+  static auto Marked(NodePtr node) -> NodePtr;
+  static auto Unmarked(NodePtr node) -> NodePtr;
+
+ private:
+  using Tower = detail::Tower<Node, AtomicNodePtr>;
+
  private:
-  AllocatorPtr allocator_{std::make_shared<TAllocator>()};
-  NodePtr head_{New({}, kMaxLevel + 1)};
-  NodePtr tail_{New({}, kMaxLevel + 1)};
+  detail::NodeAllocator<TAllocator> allocator_;
+  TCompare compare_{};
+  detail::StripedCounter size_;
+  detail::StripedCounter memory_;
+  NodePtr head_{New(kMaxLevel)};
+  NodePtr tail_{New(kMaxLevel)};
+
+  // Declared after the allocator, so retired nodes are freed before it
+  detail::EpochManager epochs_;
 };
 
 }  // namespace skipper
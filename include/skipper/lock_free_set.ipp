@@ -1,6 +1,8 @@
 #ifndef SKIPPER_LOCK_FREE_SET_IPP
 #define SKIPPER_LOCK_FREE_SET_IPP
 
+#include <algorithm>
+#include <new>
 #include <utility>
 
 #include "skipper/lock_free_set.hpp"
@@ -9,137 +11,382 @@ namespace skipper {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T, class TAllocator>
-struct LockFreeSkipListSet<T, TAllocator>::Node {
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+struct LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                           TCompare>::Node {
  public:
-  Node(T val, Level level);
+  template <typename... Args>
+  explicit Node(Level l, Args&&... args);
+
+  auto Forward(std::size_t i) -> AtomicNodePtr&;
 
  public:
   T value;
-  NodePtrList forward;
-  Flag is_erased{false};
+  Level level;
+
+  // Held by the inserting thread until it stops linking the node
+  // and by the erasing thread until the node is unlinked
+  Counter references{2};
 };
 
-template <typename T, class TAllocator>
-LockFreeSkipListSet<T, TAllocator>::Node::Node(T val, Level level)
-    : value(std::move(val)), forward(static_cast<std::size_t>(level) + 1) {
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename... Args>
+LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator, TCompare>::Node::
+    Node(Level l, Args&&... args)
+    : value(std::forward<Args>(args)...), level(l) {
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Node::Forward(std::size_t i)
+    -> AtomicNodePtr& {
+  return Tower::Links(this)[i];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T, class TAllocator>
-struct LockFreeSkipListSet<T, TAllocator>::FindResult {
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+struct LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                           TCompare>::FindResult {
   bool found;
-  NodePtrList predecessors{static_cast<std::size_t>(kMaxLevel) + 1};
-  NodePtrList successors{static_cast<std::size_t>(kMaxLevel) + 1};
+  NodePtrList predecessors{};
+  NodePtrList successors{};
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T, class TAllocator>
-LockFreeSkipListSet<T, TAllocator>::LockFreeSkipListSet() {
-  auto head = head_.load();
-  for (auto& f : head->forward) {
-    f.store(tail_);
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator, TCompare>::
+    LockFreeSkipListSet()
+    : LockFreeSkipListSet(detail::DefaultAllocator<TAllocator>()) {
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator, TCompare>::
+    LockFreeSkipListSet(const AllocatorHandle& allocator)
+    : allocator_(allocator) {
+  for (auto level = 0; level <= kMaxLevel; ++level) {
+    head_->Forward(static_cast<std::size_t>(level)).store(tail_);
   }
 }
 
-template <typename T, class TAllocator>
-auto LockFreeSkipListSet<T, TAllocator>::Contains(const T& value) -> bool {
-  const auto [found, s, p] = Find(value);
-  return found;
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                    TCompare>::~LockFreeSkipListSet() {
+  for (auto node = head_; node;) {
+    auto next = Unmarked(node->Forward(0).load());
+    Delete(node);
+    node = next;
+  }
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Contains(const T& value) -> bool {
+  return Contains<T>(value);
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename K, typename>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Contains(const K& key) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node = Seek(key);
+  return node != tail_ && !compare_(key, node->value);
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Insert(const T& value) -> bool {
+  return InsertValue(value);
 }
 
-template <typename T, class TAllocator>
-auto LockFreeSkipListSet<T, TAllocator>::Insert(const T& value) -> bool {
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Insert(T&& value) -> bool {
+  return InsertValue(std::move(value));
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename... Args>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Emplace(Args&&... args) -> bool {
+  return InsertValue(T(std::forward<Args>(args)...));
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Erase(const T& value) -> bool {
+  return Erase<T>(value);
+}
+
+// Node is marked top-down and it is erased by the thread which marks
+// its lowest level. That thread then unlinks the node with `Find`.
+//
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename K, typename>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Erase(const K& key) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
+  auto [found, predecessors, successors] = Find(key);
+  if (!found) {
+    return false;
+  }
+
+  auto node = successors[0];
+
+  for (auto level = node->level; level > 0; --level) {
+    auto& forward = node->Forward(static_cast<std::size_t>(level));
+    auto succ = forward.load();
+    while (!IsMarked(succ) &&
+           !forward.compare_exchange_weak(succ, Marked(succ))) {
+    }
+  }
+
+  auto& forward = node->Forward(0);
+  auto succ = forward.load();
+
+  while (!IsMarked(succ)) {
+    if (forward.compare_exchange_strong(succ, Marked(succ))) {
+      size_.Add(-1);
+      Find(key);
+      Release(node);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Size() -> std::size_t {
+  return static_cast<std::size_t>(std::max(size_.Load(), std::ptrdiff_t{0}));
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Empty() -> bool {
+  return Size() == 0;
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::MemoryUsage() -> std::size_t {
+  return static_cast<std::size_t>(
+      std::max(memory_.Load(), std::ptrdiff_t{0}));
+}
+
+// A node is a member of the set from the moment it is linked on the lowest
+// level until its own link on that level gets marked
+//
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename TVisitor>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::ForEachInRange(
+    const T& lo, const T& hi, TVisitor&& visitor) -> void {
+  auto epoch_guard = epochs_.Pin();
+
+  auto node = Seek(lo);
+  while (node != tail_ && compare_(node->value, hi)) {
+    auto next = node->Forward(0).load();
+    if (!IsMarked(next)) {
+      visitor(std::as_const(node->value));
+    }
+    node = Unmarked(next);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename... Args>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::New(Level level, Args&&... args)
+    -> LockFreeSkipListSet::NodePtr {
+  auto size = Tower::AllocationSize(level);
+  auto raw = allocator_.Allocate(size);
+  try {
+    auto node =
+        Tower::Construct(raw, level, level, std::forward<Args>(args)...);
+    memory_.Add(static_cast<std::ptrdiff_t>(allocator_.Footprint(size)));
+    return node;
+  } catch (...) {
+    allocator_.Deallocate(raw, size);
+    throw;
+  }
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Delete(NodePtr node) -> void {
+  auto level = node->level;
+  auto size = Tower::AllocationSize(level);
+  Tower::Destroy(node, level);
+  allocator_.Deallocate(node, size);
+  memory_.Add(-static_cast<std::ptrdiff_t>(allocator_.Footprint(size)));
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Release(NodePtr node) -> void {
+  if (node->references.fetch_sub(1) != 1) {
+    return;
+  }
+
+  epochs_.Retire(
+      node,
+      [](void* retired, void* set) {
+        static_cast<LockFreeSkipListSet*>(set)->Delete(
+            static_cast<NodePtr>(retired));
+      },
+      this);
+}
+
+// Node becomes a member of the set once it is linked on the lowest level.
+// Upper levels are linked one by one afterwards.
+//
+// Before linking the node on a level, its own link is pointed at the new
+// successor with CAS, so the node is never linked on a level which is already
+// marked by an eraser. Levels linked concurrently with erasion are unlinked
+// by the final `Find`.
+//
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename TValue>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::InsertValue(TValue&& value) -> bool {
+  auto epoch_guard = epochs_.Pin();
+
   auto node_level = GenerateRandomLevel();
+  auto node = NodePtr{};
+  // Searches go by the node's value once `value` is moved into it
+  auto lookup = &std::as_const(value);
 
   while (true) {
-    auto [found, predecessors, successors] = Find(value);
+    auto [found, predecessors, successors] = Find(*lookup);
     if (found) {
+      if (node) {
+        Delete(node);
+      }
       return false;
     }
 
-    auto node = New(value, node_level);
+    // Node is allocated at most once, failed attempts reuse it
     if (!node) {
-      return false;
+      node = New(node_level, std::forward<TValue>(value));
+      lookup = &node->value;
     }
 
     for (auto level = 0; level <= node_level; ++level) {
       auto i = static_cast<std::size_t>(level);
-      auto succ = successors[i].load();
-      node->forward[i].store(succ);
+      node->Forward(i).store(successors[i]);
     }
 
-    auto pred = predecessors[0].load();
-    auto succ = successors[0].load();
+    auto pred = predecessors[0];
+    auto succ = successors[0];
 
-    if (!pred->forward[0].compare_exchange_strong(succ, node)) {
+    if (!pred->Forward(0).compare_exchange_strong(succ, node)) {
       continue;
     }
+    size_.Add(1);
+
+    auto is_erased = false;
 
-    for (auto level = 1; level <= node_level; ++level) {
+    for (auto level = 1; !is_erased && level <= node_level; ++level) {
       auto i = static_cast<std::size_t>(level);
-      if (node->is_erased.load()) {
-        return false;
-      }
 
       while (true) {
         pred = predecessors[i];
         succ = successors[i];
-        if (pred->forward[i].compare_exchange_strong(succ, node)) {
+
+        auto next = node->Forward(i).load();
+        if (next != succ && !IsMarked(next)) {
+          node->Forward(i).compare_exchange_strong(next, succ);
+        }
+
+        if (IsMarked(next)) {
+          is_erased = true;
+          break;
+        }
+
+        if (pred->Forward(i).compare_exchange_strong(succ, node)) {
           break;
         }
 
-        auto res = Find(value);
+        auto res = Find(*lookup);
         predecessors = std::move(res.predecessors);
         successors = std::move(res.successors);
       }
     }
 
-    return true;
-  }
-}
+    if (is_erased || IsMarked(node->Forward(0).load())) {
+      Find(*lookup);
+    }
 
-////////////////////////////////////////////////////////////////////////////////
+    Release(node);
 
-template <typename T, class TAllocator>
-auto LockFreeSkipListSet<T, TAllocator>::New(const T& value, Level level)
-    -> LockFreeSkipListSet::Node* {
-  if (auto raw = allocator_->Allocate(sizeof(Node))) {
-    return new (raw) Node(value, level);
-  } else {
-    return nullptr;
+    return true;
   }
 }
 
-template <typename T, class TAllocator>
-auto LockFreeSkipListSet<T, TAllocator>::Find(const T& value)
+// Unlinks every marked node met on the way, so when `Find(key)` returns,
+// nodes equal to `key` which had been marked before are unreachable.
+//
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename K>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Find(const K& key)
     -> LockFreeSkipListSet::FindResult {
   auto result = FindResult{};
 
 retry:
   while (true) {
-    auto pred = head_.load();
-    auto curr = NodePtr{}.load();
+    auto pred = head_;
+    auto curr = NodePtr{};
 
     for (auto level = kMaxLevel; level >= 0; --level) {
       auto i = static_cast<std::size_t>(level);
 
-      curr = pred->forward[i];
+      curr = Unmarked(pred->Forward(i).load());
       while (true) {
-        auto succ = curr->forward[i].load();
+        auto succ = curr->Forward(i).load();
 
-        while (curr->is_erased.load()) {
-          if (!pred->forward[i].compare_exchange_strong(curr, succ)) {
+        while (IsMarked(succ)) {
+          succ = Unmarked(succ);
+          if (!pred->Forward(i).compare_exchange_strong(curr, succ)) {
             goto retry;
           }
 
-          curr = pred->forward[i];
-          succ = curr->forward[i];
+          curr = succ;
+          succ = curr->Forward(i).load();
         }
 
-        if (curr != tail_ && curr->value < value) {
+        if (curr != tail_ && compare_(curr->value, key)) {
           pred = std::exchange(curr, succ);
         } else {
           break;
@@ -150,20 +397,75 @@ retry:
       result.successors[i] = curr;
     }
 
-    result.found = curr != tail_ && curr->value == value;
+    result.found = curr != tail_ && !compare_(key, curr->value);
     return result;
   }
 }
 
-template <typename T, class TAllocator>
-auto LockFreeSkipListSet<T, TAllocator>::GenerateRandomLevel()
-    -> LockFreeSkipListSet::Level {
-  auto level = Level{0};
-  while (level < kMaxLevel &&
-         static_cast<Probability>(std::rand()) / RAND_MAX < kProbability) {
-    ++level;
+// Unlike `Find`, does not help to unlink erased nodes,
+// so readers never write to shared memory.
+//
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+template <typename K>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Seek(const K& key)
+    -> LockFreeSkipListSet::NodePtr {
+  auto pred = head_;
+  auto curr = NodePtr{};
+
+  for (auto level = kMaxLevel; level >= 0; --level) {
+    auto i = static_cast<std::size_t>(level);
+
+    curr = Unmarked(pred->Forward(i).load());
+    while (true) {
+      auto succ = curr->Forward(i).load();
+      while (IsMarked(succ)) {
+        curr = Unmarked(succ);
+        succ = curr->Forward(i).load();
+      }
+
+      if (curr != tail_ && compare_(curr->value, key)) {
+        pred = std::exchange(curr, succ);
+      } else {
+        break;
+      }
+    }
   }
-  return level;
+
+  return curr;
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::GenerateRandomLevel()
+    -> LockFreeSkipListSet::Level {
+  return TLevelGenerator::Generate(kMaxLevel);
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::IsMarked(NodePtr node) -> bool {
+  return (reinterpret_cast<std::uintptr_t>(node) & 1) != 0;
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Marked(NodePtr node)
+    -> LockFreeSkipListSet::NodePtr {
+  return reinterpret_cast<NodePtr>(reinterpret_cast<std::uintptr_t>(node) | 1);
+}
+
+template <typename T, class TAllocator, int TMaxLevel, class TLevelGenerator,
+          class TCompare>
+auto LockFreeSkipListSet<T, TAllocator, TMaxLevel, TLevelGenerator,
+                         TCompare>::Unmarked(NodePtr node)
+    -> LockFreeSkipListSet::NodePtr {
+  auto bits = reinterpret_cast<std::uintptr_t>(node);
+  return reinterpret_cast<NodePtr>(bits & ~std::uintptr_t{1});
 }
 
 }  // namespace skipper
@@ -1,13 +1,24 @@
 #ifndef SKIPPER_SEQUENTIAL_MAP_HPP
 #define SKIPPER_SEQUENTIAL_MAP_HPP
 
+#include <functional>
 #include <memory>
-#include <vector>
 #include <tuple>
+#include <utility>
+#include <vector>
+
+#include "skipper/detail/compare.hpp"
+#include "skipper/detail/level_generator.hpp"
+#include "skipper/detail/node_allocator.hpp"
+#include "skipper/detail/tower.hpp"
 
 namespace skipper {
 
-template <typename Key, typename Value>
+// Keys are ordered by `TCompare`, see `SequentialSkipListSet`
+template <typename Key, typename Value, int TMaxLevel = 4,
+          class TLevelGenerator = detail::XorShiftLevelGenerator<>,
+          class TAllocator = std::allocator<std::pair<const Key, Value>>,
+          class TCompare = std::less<Key>>
 class SequentialSkipListMap {
  private:
   struct Node;
@@ -16,8 +27,12 @@ class SequentialSkipListMap {
   using Level = int;
   using Probability = double;
 
-  static constexpr auto kMaxLevel = Level{4};
-  static constexpr auto kProbability = Probability{0.2};
+  static constexpr auto kMaxLevel = Level{TMaxLevel};
+  static constexpr auto kProbability = TLevelGenerator::kProbability;
+
+  static_assert(kMaxLevel >= 0, "Maximum level must be non-negative");
+
+  using AllocatorHandle = typename detail::NodeAllocator<TAllocator>::Handle;
 
  public:
   class Element {
@@ -44,39 +59,123 @@ class SequentialSkipListMap {
   };
 
  public:
-  SequentialSkipListMap() = default;
-
-  SequentialSkipListMap(SequentialSkipListMap&& other) = delete;
+  SequentialSkipListMap();
+  explicit SequentialSkipListMap(const AllocatorHandle& allocator);
+
+  // Builds the map from a range of key-value pairs with strictly
+  // increasing keys in O(N)
+  template <typename TInputIterator>
+  static auto FromSorted(
+      TInputIterator first, TInputIterator last,
+      const AllocatorHandle& allocator = detail::DefaultAllocator<TAllocator>())
+      -> SequentialSkipListMap;
+
+  // A move constructor takes nodes over in O(1), but allocates a new head
+  // for `other`, which is left empty, so it throws if memory is exhausted.
+  // A move assignment takes nodes over as well if allocators propagate on
+  // container move assignment or compare equal, otherwise it moves values
+  // into new nodes in O(N). Either way `other` is left empty.
+  SequentialSkipListMap(SequentialSkipListMap&& other);
   SequentialSkipListMap(const SequentialSkipListMap& other) = delete;
-  SequentialSkipListMap& operator=(SequentialSkipListMap&& other) = delete;
+  SequentialSkipListMap& operator=(SequentialSkipListMap&& other);
   SequentialSkipListMap& operator=(const SequentialSkipListMap& other) = delete;
 
   ~SequentialSkipListMap();
 
+  // Exchanges contents in O(1). Iterators stay valid and refer to the other
+  // map afterwards. Allocators which do not propagate on container swap
+  // have to compare equal, see `detail::NodeAllocator::Swap`.
+  auto Swap(SequentialSkipListMap& other) -> void;
+
   // STL map-like interface
   auto Find(const Key& key) const -> Iterator;
 
   auto Insert(const Key& key, const Value& value) -> std::pair<Iterator, bool>;
+  auto Insert(Key&& key, Value&& value) -> std::pair<Iterator, bool>;
   auto operator[](const Key& key) -> Value&;
 
+  // Constructs the value from `args` right in a new node if there is
+  // no such key yet, otherwise leaves `args` untouched
+  template <typename... Args>
+  auto TryEmplace(const Key& key, Args&&... args) -> std::pair<Iterator, bool>;
+  template <typename... Args>
+  auto TryEmplace(Key&& key, Args&&... args) -> std::pair<Iterator, bool>;
+
   auto Erase(const Key& key) -> std::size_t;
 
+  // See `SequentialSkipListSet::Clear`
+  auto Clear() -> void;
+
+  // Heterogeneous lookups, available with a transparent `TCompare` only
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, Key>>
+  auto Find(const K& key) const -> Iterator;
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, Key>>
+  auto Erase(const K& key) -> std::size_t;
+
+  // Inserts key-value pairs from the range, keeping values of present keys,
+  // and returns the number of new keys. Every search continues from the
+  // previous key, see `SequentialSkipListSet::InsertRange` for the costs.
+  template <typename TInputIterator>
+  auto InsertRange(TInputIterator first, TInputIterator last) -> std::size_t;
+
+  // Ordered lookups in O(log N), see std::map for the semantics
+  auto LowerBound(const Key& key) const -> Iterator;
+  auto UpperBound(const Key& key) const -> Iterator;
+  auto EqualRange(const Key& key) const -> std::pair<Iterator, Iterator>;
+
+  // O(1) complexity
+  auto Size() const -> std::size_t;
+  auto Empty() const -> bool;
+
+  // Bytes taken from the allocator by all nodes and the head sentinel,
+  // each of them rounded up as the allocator does it
+  auto MemoryUsage() const -> std::size_t;
+
   // Iteration interface
   auto Begin() const -> Iterator;
   auto End() const -> Iterator;
 
  private:
-  using NodePtr = std::shared_ptr<Node>;
+  using NodePtr = Node*;
   using NodePtrList = std::vector<NodePtr>;
 
  private:
-  auto Traverse(const Key& key, NodePtrList* update = nullptr) const -> NodePtr;
+  template <typename TInputIterator>
+  SequentialSkipListMap(const AllocatorHandle& allocator, TInputIterator first,
+                        TInputIterator last);
+
+  template <typename K>
+  auto Traverse(const K& key, NodePtrList* update = nullptr) const -> NodePtr;
+  auto TraverseFrom(const Key& key, NodePtrList& finger) const -> NodePtr;
+
+  template <typename TKey, typename... Args>
+  auto InsertKey(TKey&& key, Args&&... args) -> std::pair<Iterator, bool>;
+
+  auto Link(NodePtr new_node, NodePtrList& update) -> NodePtr;
+  // Links `new_node` after `last_nodes`, which end every level,
+  // and replaces them with it
+  auto Append(NodePtr new_node, NodePtrList& last_nodes) -> void;
+  // Same as `Swap`, but leaves allocators in place
+  auto SwapContents(SequentialSkipListMap& other) -> void;
 
   auto GenerateRandomLevel() const -> Level;
 
+  template <typename TKey, typename... Args>
+  auto New(Level level, TKey&& key, Args&&... args) -> NodePtr;
+  auto Delete(NodePtr node) -> void;
+  auto DeleteNodes() -> void;
+
+ private:
+  using Tower = detail::Tower<Node, NodePtr>;
+
  private:
+  detail::NodeAllocator<TAllocator> allocator_;
+  TCompare compare_{};
   Level level_{0};
-  NodePtr head_{std::make_shared<Node>(Key{}, Value{}, kMaxLevel)};
+  std::size_t size_{0};
+  // Has to be initialized before `head_` is allocated
+  std::size_t memory_{0};
+  NodePtr head_{New(kMaxLevel, Key{})};
 };
 
 }  // namespace skipper
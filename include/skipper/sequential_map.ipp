@@ -3,7 +3,8 @@
 
 #include <algorithm>
 #include <iostream>
-#include <memory>
+#include <new>
+#include <type_traits>
 #include <stdexcept>
 #include <utility>
 
@@ -13,211 +14,622 @@ namespace skipper {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename Key, typename Value>
-struct SequentialSkipListMap<Key, Value>::Node {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+struct SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                             TCompare>::Node {
  public:
-  Node(Key key, Value value, Level level);
+  template <typename TKey, typename... Args>
+  Node(Level l, TKey&& key, Args&&... args);
 
+  auto Forward(std::size_t i) -> NodePtr&;
+  auto Forward(std::size_t i) const -> NodePtr;
   auto Next() const -> Node*;
 
  public:
   Element element;
-  NodePtrList forward;
+  const Level level;
 };
 
-template <typename Key, typename Value>
-SequentialSkipListMap<Key, Value>::Node::Node(Key k, Value v, Level level)
-    : element{std::move(k), std::move(v)},
-      forward(static_cast<std::size_t>(level) + 1) {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename TKey, typename... Args>
+SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::Node::Node(Level l, TKey&& key,
+                                              Args&&... args)
+    : element{std::forward<TKey>(key), Value(std::forward<Args>(args)...)},
+      level(l) {
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Node::Next() const
-    -> SequentialSkipListMap<Key, Value>::Node* {
-  return forward[0].get();
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Node::Forward(std::size_t i)
+    -> NodePtr& {
+  return Tower::Links(this)[i];
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Node::Forward(std::size_t i) const
+    -> NodePtr {
+  return Tower::Links(this)[i];
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Node::Next() const
+    -> SequentialSkipListMap::Node* {
+  return Forward(0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename Key, typename Value>
-SequentialSkipListMap<Key, Value>::Iterator::Iterator(
-    SequentialSkipListMap::Node* ptr)
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::Iterator::Iterator(Node* ptr)
     : ptr_(ptr) {
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Iterator::operator*() -> Element& {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator*() -> Element& {
   return ptr_->element;
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Iterator::operator*() const
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator*() const
     -> const Element& {
   return ptr_->element;
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Iterator::operator->() -> Element* {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator->() -> Element* {
   return &ptr_->element;
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Iterator::operator->() const
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator->() const
     -> const Element* {
   return &ptr_->element;
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Iterator::operator++(/* prefix */)
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator++(/* prefix */)
     -> SequentialSkipListMap::Iterator& {
   ptr_ = ptr_->Next();
   return *this;
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Iterator::operator++(int /* postfix */)
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator++(int /* postfix */)
     -> SequentialSkipListMap::Iterator {
   auto copy = *this;
   ++(*this);
   return copy;
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Iterator::operator==(
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator==(
     const SequentialSkipListMap::Iterator& other) const -> bool {
   return ptr_ == other.ptr_;
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Iterator::operator!=(
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator!=(
     const SequentialSkipListMap::Iterator& other) const -> bool {
   return !(*this == other);  // NOLINT (simplification will lead to recursion)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename Key, typename Value>
-SequentialSkipListMap<Key, Value>::~SequentialSkipListMap() {
-  for (auto node = head_; node;) {
-    auto next = node->forward[0];
-    node->forward.clear();
-    node = next;
-  }
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::SequentialSkipListMap()
+    : SequentialSkipListMap(detail::DefaultAllocator<TAllocator>()) {
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Find(const Key& key) const
-    -> SequentialSkipListMap::Iterator {
-  if (auto node = Traverse(key); node && !(key < node->element.key)) {
-    return Iterator{node.get()};
-  } else {
-    return End();
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::
+    SequentialSkipListMap(const AllocatorHandle& allocator)
+    : allocator_(allocator) {
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename TInputIterator>
+SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::
+    SequentialSkipListMap(const AllocatorHandle& allocator,
+                          TInputIterator first, TInputIterator last)
+    : SequentialSkipListMap(allocator) {
+  auto last_nodes = NodePtrList(kMaxLevel + 1, head_);
+  for (; first != last; ++first) {
+    const auto& [key, value] = *first;
+    Append(New(GenerateRandomLevel(), key, value), last_nodes);
   }
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Insert(const Key& key,
-                                               const Value& value)
-    -> std::pair<Iterator, bool> {
-  auto update = NodePtrList{kMaxLevel + 1};
-  auto node = Traverse(key, &update);
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename TInputIterator>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::FromSorted(
+    TInputIterator first, TInputIterator last, const AllocatorHandle& allocator)
+    -> SequentialSkipListMap {
+  return SequentialSkipListMap(allocator, first, last);
+}
+
+// See `SequentialSkipListSet`
+//
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::
+    SequentialSkipListMap(SequentialSkipListMap&& other)
+    : allocator_(other.allocator_) {
+  Swap(other);
+}
 
-  if (node && !(key < node->element.key)) {
-    return {Iterator{node.get()}, false};
+// See `SequentialSkipListSet`
+//
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::operator=(SequentialSkipListMap&& other)
+    -> SequentialSkipListMap& {
+  if (this == &other) {
+    return *this;
   }
 
-  auto node_level = GenerateRandomLevel();
-  if (node_level > level_) {
-    std::fill(std::begin(update) + level_ + 1,
-              std::begin(update) + node_level + 1, head_);
-    level_ = node_level;
+  if (allocator_.Adopts(other.allocator_)) {
+    auto moved = SequentialSkipListMap(std::move(other));
+    allocator_.SwapOnMove(moved.allocator_);
+    SwapContents(moved);
+    return *this;
   }
 
-  auto new_node = std::make_shared<Node>(key, value, node_level);
-  for (auto level = Level{0}; level <= node_level; ++level) {
-    auto i = static_cast<std::size_t>(level);
-    new_node->forward[i] = std::exchange(update[i]->forward[i], new_node);
+  Clear();
+  auto last_nodes = NodePtrList(kMaxLevel + 1, head_);
+  for (auto node = other.head_->Next(); node; node = node->Next()) {
+    auto& [key, value] = node->element;
+    Append(New(node->level, std::move(key), std::move(value)), last_nodes);
+  }
+  other.Clear();
+
+  return *this;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::~SequentialSkipListMap() {
+  // See `SequentialSkipListSet::~SequentialSkipListSet`
+  auto releases_in_bulk = false;
+  if constexpr (detail::kReleasesInBulk<TAllocator> &&
+                std::is_trivially_destructible_v<Node>) {
+    releases_in_bulk = allocator_.IsSoleOwner();
   }
 
-  return {Iterator{new_node.get()}, true};
+  if (!releases_in_bulk) {
+    DeleteNodes();
+  }
+  Delete(head_);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Swap(SequentialSkipListMap& other)
+    -> void {
+  allocator_.Swap(other.allocator_);
+  SwapContents(other);
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::operator[](const Key& key) -> Value& {
-  if (auto node = Find(key); node != End()) {
-    return node->value;
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::SwapContents(SequentialSkipListMap& other)
+    -> void {
+  std::swap(compare_, other.compare_);
+  std::swap(level_, other.level_);
+  std::swap(size_, other.size_);
+  std::swap(memory_, other.memory_);
+  std::swap(head_, other.head_);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Find(const Key& key) const
+    -> SequentialSkipListMap::Iterator {
+  return Find<Key>(key);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename K, typename>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Find(const K& key) const
+    -> SequentialSkipListMap::Iterator {
+  if (auto node = Traverse(key); node && !compare_(key, node->element.key)) {
+    return Iterator{node};
   } else {
-    auto p = Insert(key, Value{});
-    return p.first->value;
+    return End();
   }
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Erase(const Key& key) -> std::size_t {
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Insert(
+    const Key& key, const Value& value) -> std::pair<Iterator, bool> {
+  return InsertKey(key, value);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Insert(Key&& key, Value&& value)
+    -> std::pair<Iterator, bool> {
+  return InsertKey(std::move(key), std::move(value));
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::operator[](const Key& key) -> Value& {
+  return TryEmplace(key).first->value;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename... Args>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::TryEmplace(
+    const Key& key, Args&&... args) -> std::pair<Iterator, bool> {
+  return InsertKey(key, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename... Args>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::TryEmplace(
+    Key&& key, Args&&... args) -> std::pair<Iterator, bool> {
+  return InsertKey(std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Erase(const Key& key) -> std::size_t {
+  return Erase<Key>(key);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename K, typename>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Erase(const K& key) -> std::size_t {
   auto update = NodePtrList{kMaxLevel + 1};
   auto node = Traverse(key, &update);
 
-  if (!node || key < node->element.key) {
+  if (!node || compare_(key, node->element.key)) {
     return 0;
   }
 
   for (auto level = Level{0}; level <= level_; ++level) {
     auto i = static_cast<std::size_t>(level);
-    if (update[i]->forward[i] != node) {
+    if (update[i]->Forward(i) != node) {
       break;
     }
-    update[i]->forward[i] = node->forward[i];
+    update[i]->Forward(i) = node->Forward(i);
   }
+  Delete(node);
+  --size_;
 
-  while (level_ > 0 && !head_->forward[static_cast<std::size_t>(level_)]) {
+  while (level_ > 0 && !head_->Forward(static_cast<std::size_t>(level_))) {
     --level_;
   }
 
   return 1;
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Begin() const
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Clear() -> void {
+  DeleteNodes();
+  for (auto level = Level{0}; level <= level_; ++level) {
+    head_->Forward(static_cast<std::size_t>(level)) = nullptr;
+  }
+  level_ = 0;
+  size_ = 0;
+}
+
+// See `SequentialSkipListSet::InsertRange` for the finger search
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename TInputIterator>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::InsertRange(
+    TInputIterator first, TInputIterator last) -> std::size_t {
+  auto finger = NodePtrList(kMaxLevel + 1, head_);
+  auto inserted = std::size_t{0};
+
+  for (; first != last; ++first) {
+    const auto& [key, value] = *first;
+
+    if (finger[0] != head_ && !compare_(finger[0]->element.key, key)) {
+      std::fill(std::begin(finger), std::end(finger), head_);
+    }
+
+    auto node = TraverseFrom(key, finger);
+    if (node && !compare_(key, node->element.key)) {
+      continue;
+    }
+
+    auto new_node = Link(New(GenerateRandomLevel(), key, value), finger);
+    std::fill(std::begin(finger), std::begin(finger) + new_node->level + 1,
+              new_node);
+    ++inserted;
+  }
+
+  return inserted;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::LowerBound(const Key& key) const
+    -> SequentialSkipListMap::Iterator {
+  return Iterator{Traverse(key)};
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::UpperBound(const Key& key) const
+    -> SequentialSkipListMap::Iterator {
+  return EqualRange(key).second;
+}
+
+// Keys are unique, so the range holds at most one element
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::EqualRange(const Key& key) const
+    -> std::pair<Iterator, Iterator> {
+  auto node = Traverse(key);
+  if (node && !compare_(key, node->element.key)) {
+    return {Iterator{node}, Iterator{node->Next()}};
+  }
+  return {Iterator{node}, Iterator{node}};
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Size() const -> std::size_t {
+  return size_;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Empty() const -> bool {
+  return size_ == 0;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::MemoryUsage() const
+    -> std::size_t {
+  return memory_;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Begin() const
     -> SequentialSkipListMap::Iterator {
   return Iterator{head_->Next()};
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::End() const
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::End() const
     -> SequentialSkipListMap::Iterator {
   return Iterator{nullptr};
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::Traverse(
-    const Key& key, SequentialSkipListMap::NodePtrList* update) const
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename TKey, typename... Args>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::InsertKey(
+    TKey&& key, Args&&... args) -> std::pair<Iterator, bool> {
+  auto update = NodePtrList{kMaxLevel + 1};
+  auto node = Traverse(key, &update);
+
+  if (node && !compare_(key, node->element.key)) {
+    return {Iterator{node}, false};
+  }
+
+  auto new_node = New(GenerateRandomLevel(), std::forward<TKey>(key),
+                      std::forward<Args>(args)...);
+  return {Iterator{Link(new_node, update)}, true};
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename K>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Traverse(
+    const K& key, SequentialSkipListMap::NodePtrList* update) const
     -> SequentialSkipListMap::NodePtr {
   auto node = head_;
 
   for (auto level = level_; level >= 0; --level) {
     auto i = static_cast<std::size_t>(level);
-    while (node->forward[i] && node->forward[i]->element.key < key) {
-      node = node->forward[i];
+    while (node->Forward(i) && compare_(node->Forward(i)->element.key, key)) {
+      node = node->Forward(i);
     }
     if (update) {
       (*update)[i] = node;
     }
   }
 
-  return node->forward[0];
+  return node->Next();
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::TraverseFrom(
+    const Key& key, NodePtrList& finger) const
+    -> SequentialSkipListMap::NodePtr {
+  auto top = Level{0};
+  while (top < level_) {
+    auto next = finger[static_cast<std::size_t>(top) + 1]->Forward(
+        static_cast<std::size_t>(top) + 1);
+    if (!next || !compare_(next->element.key, key)) {
+      break;
+    }
+    ++top;
+  }
+
+  auto node = head_;
+  auto moved = false;
+
+  for (auto level = top; level >= 0; --level) {
+    auto i = static_cast<std::size_t>(level);
+    if (!moved) {
+      node = finger[i];
+    }
+    while (node->Forward(i) && compare_(node->Forward(i)->element.key, key)) {
+      node = node->Forward(i);
+      moved = true;
+    }
+    finger[i] = node;
+  }
+
+  return node->Next();
 }
 
-template <typename Key, typename Value>
-auto SequentialSkipListMap<Key, Value>::GenerateRandomLevel() const
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Link(
+    NodePtr new_node, NodePtrList& update) -> SequentialSkipListMap::NodePtr {
+  auto node_level = new_node->level;
+  if (node_level > level_) {
+    std::fill(std::begin(update) + level_ + 1,
+              std::begin(update) + node_level + 1, head_);
+    level_ = node_level;
+  }
+
+  for (auto level = Level{0}; level <= node_level; ++level) {
+    auto i = static_cast<std::size_t>(level);
+    new_node->Forward(i) = std::exchange(update[i]->Forward(i), new_node);
+  }
+  ++size_;
+
+  return new_node;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Append(NodePtr new_node,
+                                             NodePtrList& last_nodes) -> void {
+  auto node_level = new_node->level;
+  for (auto level = Level{0}; level <= node_level; ++level) {
+    auto i = static_cast<std::size_t>(level);
+    last_nodes[i]->Forward(i) = new_node;
+    last_nodes[i] = new_node;
+  }
+  level_ = std::max(level_, node_level);
+  ++size_;
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::GenerateRandomLevel() const
     -> SequentialSkipListMap::Level {
-  auto level = Level{0};
-  while (level < kMaxLevel &&
-         static_cast<Probability>(std::rand()) / RAND_MAX < kProbability) {
-    ++level;
+  return TLevelGenerator::Generate(kMaxLevel);
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+template <typename TKey, typename... Args>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::New(
+    Level level, TKey&& key, Args&&... args)
+    -> SequentialSkipListMap::NodePtr {
+  auto size = Tower::AllocationSize(level);
+  auto raw = allocator_.Allocate(size);
+  try {
+    auto node = Tower::Construct(raw, level, level, std::forward<TKey>(key),
+                                 std::forward<Args>(args)...);
+    memory_ += allocator_.Footprint(size);
+    return node;
+  } catch (...) {
+    allocator_.Deallocate(raw, size);
+    throw;
+  }
+}
+
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Delete(
+    SequentialSkipListMap::NodePtr node) -> void {
+  auto level = node->level;
+  auto size = Tower::AllocationSize(level);
+  Tower::Destroy(node, level);
+  allocator_.Deallocate(node, size);
+  memory_ -= allocator_.Footprint(size);
+}
+
+// See `SequentialSkipListSet::DeleteNodes`
+//
+template <typename Key, typename Value, int TMaxLevel, class TLevelGenerator,
+          class TAllocator, class TCompare>
+auto SequentialSkipListMap<Key, Value, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::DeleteNodes() -> void {
+  for (auto node = head_->Next(); node;) {
+    auto next = node->Next();
+    Delete(node);
+    node = next;
   }
-  return level;
 }
 
 }  // namespace skipper
@@ -1,13 +1,32 @@
 #ifndef SKIPPER_SEQUENTIAL_SET_HPP
 #define SKIPPER_SEQUENTIAL_SET_HPP
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <vector>
 
+#include "skipper/detail/compare.hpp"
+#include "skipper/detail/level_generator.hpp"
+#include "skipper/detail/node_allocator.hpp"
+#include "skipper/detail/tower.hpp"
+
 namespace skipper {
 
-template <typename T>
+// `TMaxLevel` bounds the height of towers, so the list stays balanced
+// (i.e. O(log N) per operation) up to roughly (1 / kProbability)^TMaxLevel
+// elements. Pick a greater value for larger sets.
+//
+// Values are ordered by `TCompare`, and two values are equal if neither
+// of them precedes the other. A transparent comparator (the one which
+// declares `is_transparent`, like `std::less<>`) enables lookups by any
+// type it can compare with `T`.
+//
+// Nodes are allocated from `TAllocator`, see `detail::NodeAllocator`
+// for the allocators which are accepted.
+template <typename T, int TMaxLevel = 4,
+          class TLevelGenerator = detail::XorShiftLevelGenerator<>,
+          class TAllocator = std::allocator<T>, class TCompare = std::less<T>>
 class SequentialSkipListSet {
  private:
   struct Node;  // Forward declaration for Iterator
@@ -16,13 +35,17 @@ class SequentialSkipListSet {
   using Level = int;
   using Probability = double;
 
-  using NodePtr = std::shared_ptr<Node>;
+  using NodePtr = Node*;
   using NodePtrList = std::vector<NodePtr>;
 
-  static constexpr auto kMaxLevel = Level{4};
-  static constexpr auto kProbability = Probability{0.2};
+  using AllocatorHandle = typename detail::NodeAllocator<TAllocator>::Handle;
+
+  static constexpr auto kMaxLevel = Level{TMaxLevel};
+  static constexpr auto kProbability = TLevelGenerator::kProbability;
+
+  static constexpr auto kSupportsMove = true;
 
-  static constexpr auto kSupportsMove = false;
+  static_assert(kMaxLevel >= 0, "Maximum level must be non-negative");
 
  public:
   class Iterator {
@@ -41,33 +64,122 @@ class SequentialSkipListSet {
   };
 
  public:
-  SequentialSkipListSet() = default;
-
-  // TODO(Lev): investigate possible dangers of default ones
-  SequentialSkipListSet(SequentialSkipListSet&& other) = delete;
+  SequentialSkipListSet();
+  explicit SequentialSkipListSet(const AllocatorHandle& allocator);
+
+  // Builds the set from a range of strictly increasing values in O(N),
+  // linking every node right after the previous one without a search
+  template <typename TInputIterator>
+  static auto FromSorted(
+      TInputIterator first, TInputIterator last,
+      const AllocatorHandle& allocator = detail::DefaultAllocator<TAllocator>())
+      -> SequentialSkipListSet;
+
+  // A move constructor takes nodes over in O(1), but allocates a new head
+  // for `other`, which is left empty, so it throws if memory is exhausted.
+  // A move assignment takes nodes over as well if allocators propagate on
+  // container move assignment or compare equal, otherwise it moves values
+  // into new nodes in O(N). Either way `other` is left empty.
+  SequentialSkipListSet(SequentialSkipListSet&& other);
   SequentialSkipListSet(const SequentialSkipListSet& other) = delete;
-  SequentialSkipListSet& operator=(SequentialSkipListSet&& other) = delete;
+  SequentialSkipListSet& operator=(SequentialSkipListSet&& other);
   SequentialSkipListSet& operator=(const SequentialSkipListSet& other) = delete;
 
   ~SequentialSkipListSet();
 
+  // Exchanges contents in O(1). Iterators stay valid and refer to the other
+  // set afterwards. Allocators which do not propagate on container swap
+  // have to compare equal, see `detail::NodeAllocator::Swap`.
+  auto Swap(SequentialSkipListSet& other) -> void;
+
   // STL set-like interface
   auto Find(const T& value) const -> Iterator;
   auto Insert(const T& value) -> std::pair<Iterator, bool>;
+  auto Insert(T&& value) -> std::pair<Iterator, bool>;
   auto Erase(const T& value) -> std::size_t;
 
+  // Erases every value in O(N). Nodes go back to the allocator one by one,
+  // so that one which reuses blocks, like `detail::Arena`, hands them out
+  // again when the set is refilled.
+  auto Clear() -> void;
+
+  // Constructs a value from `args` and moves it into a new node,
+  // which is allocated only if there is no equal value yet
+  template <typename... Args>
+  auto Emplace(Args&&... args) -> std::pair<Iterator, bool>;
+
+  // Heterogeneous lookups, available with a transparent `TCompare` only
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, T>>
+  auto Find(const K& key) const -> Iterator;
+  template <typename K, typename = detail::EnableIfLookupKey<TCompare, K, T>>
+  auto Erase(const K& key) -> std::size_t;
+
+  // Inserts values from the range and returns how many of them were new.
+  // Every search resumes from where the previous value landed, so a value
+  // of a sorted range costs O(log D), D being the number of nodes between
+  // it and the previous one. A sorted range which falls into a gap of
+  // the set, e.g. one inserted into an empty set, takes O(N) in total.
+  template <typename TInputIterator>
+  auto InsertRange(TInputIterator first, TInputIterator last) -> std::size_t;
+
+  // Ordered lookups in O(log N), see std::set for the semantics
+  auto LowerBound(const T& value) const -> Iterator;
+  auto UpperBound(const T& value) const -> Iterator;
+  auto EqualRange(const T& value) const -> std::pair<Iterator, Iterator>;
+
+  // O(1) complexity
+  auto Size() const -> std::size_t;
+  auto Empty() const -> bool;
+
+  // Bytes taken from the allocator by all nodes and the head sentinel,
+  // each of them rounded up as the allocator does it
+  auto MemoryUsage() const -> std::size_t;
+
   // Iteration interface
   auto Begin() const -> Iterator;
   auto End() const -> Iterator;
 
  private:
-  auto Traverse(const T& value, NodePtrList* update = nullptr) const -> NodePtr;
+  template <typename TInputIterator>
+  SequentialSkipListSet(const AllocatorHandle& allocator, TInputIterator first,
+                        TInputIterator last);
+
+  template <typename K>
+  auto Traverse(const K& key, NodePtrList* update = nullptr) const -> NodePtr;
+  // Same as `Traverse`, but starts from `finger`, which holds predecessors
+  // of some value lesser than `value`, and updates it to those of `value`
+  auto TraverseFrom(const T& value, NodePtrList& finger) const -> NodePtr;
+
+  template <typename TValue>
+  auto InsertValue(TValue&& value) -> std::pair<Iterator, bool>;
+
+  // Links `new_node` right after `update` nodes
+  auto Link(NodePtr new_node, NodePtrList& update) -> NodePtr;
+  // Links `new_node` after `last_nodes`, which end every level,
+  // and replaces them with it
+  auto Append(NodePtr new_node, NodePtrList& last_nodes) -> void;
+  // Same as `Swap`, but leaves allocators in place
+  auto SwapContents(SequentialSkipListSet& other) -> void;
 
   auto GenerateRandomLevel() const -> Level;
 
+  // Constructs the value of a new node from `args`
+  template <typename... Args>
+  auto New(Level level, Args&&... args) -> NodePtr;
+  auto Delete(NodePtr node) -> void;
+  auto DeleteNodes() -> void;
+
+ private:
+  using Tower = detail::Tower<Node, NodePtr>;
+
  private:
+  detail::NodeAllocator<TAllocator> allocator_;
+  TCompare compare_{};
   Level level_{0};
-  NodePtr head_{std::make_shared<Node>(T{}, kMaxLevel)};
+  std::size_t size_{0};
+  // Declared before `head_`, so the head is accounted for
+  std::size_t memory_{0};
+  NodePtr head_{New(kMaxLevel)};
 };
 
 }  // namespace skipper
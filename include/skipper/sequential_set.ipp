@@ -3,7 +3,8 @@
 
 #include <algorithm>
 #include <iostream>
-#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 #include "skipper/sequential_set.hpp"
@@ -12,84 +13,249 @@ namespace skipper {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-struct SequentialSkipListSet<T>::Node {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+struct SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                             TCompare>::Node {
  public:
-  Node(T v, Level level);
+  template <typename... Args>
+  explicit Node(Level l, Args&&... args);
 
+  auto Forward(std::size_t i) -> NodePtr&;
+  auto Forward(std::size_t i) const -> NodePtr;
   auto Next() const -> Node*;
 
  public:
-  const T value;
-  NodePtrList forward;
+  // Not const, so that a move assignment may move it into another node
+  T value;
+  const Level level;
 };
 
-template <typename T>
-SequentialSkipListSet<T>::Node::Node(T v, Level level)
-    : value(std::move(v)), forward(static_cast<std::size_t>(level) + 1) {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename... Args>
+SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::Node::Node(Level l, Args&&... args)
+    : value(std::forward<Args>(args)...), level(l) {
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::Node::Next() const
-    -> SequentialSkipListSet<T>::Node* {
-  return forward[0].get();
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Node::Forward(std::size_t i)
+    -> NodePtr& {
+  return Tower::Links(this)[i];
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Node::Forward(std::size_t i) const
+    -> NodePtr {
+  return Tower::Links(this)[i];
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Node::Next() const
+    -> SequentialSkipListSet::Node* {
+  return Forward(0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-SequentialSkipListSet<T>::Iterator::Iterator(SequentialSkipListSet::Node* ptr)
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::Iterator::
+    Iterator(SequentialSkipListSet::Node* ptr)
     : ptr_(ptr) {
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::Iterator::operator*() const -> const T& {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator*() const
+    -> const T& {
   return ptr_->value;
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::Iterator::operator->() const -> const T* {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator->() const
+    -> const T* {
   return &ptr_->value;
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::Iterator::operator++(/* prefix */)
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator++(/* prefix */)
     -> SequentialSkipListSet::Iterator& {
   ptr_ = ptr_->Next();
   return *this;
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::Iterator::operator++(int /* postfix */)
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator++(int /* postfix */)
     -> SequentialSkipListSet::Iterator {
   const auto copy = *this;
   ++(*this);
   return copy;
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::Iterator::operator==(
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator==(
     const SequentialSkipListSet::Iterator& other) const -> bool {
   return ptr_ == other.ptr_;
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::Iterator::operator!=(
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Iterator::operator!=(
     const SequentialSkipListSet::Iterator& other) const -> bool {
   return !(*this == other);  // NOLINT (simplification will lead to recursion)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-SequentialSkipListSet<T>::~SequentialSkipListSet() {
-  for (auto node = head_; node;) {
-    const auto next = node->forward[0];
-    node->forward.clear();
-    node = next;
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator, TCompare>::
+    SequentialSkipListSet()
+    : SequentialSkipListSet(detail::DefaultAllocator<TAllocator>()) {
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator, TCompare>::
+    SequentialSkipListSet(const AllocatorHandle& allocator)
+    : allocator_(allocator) {
+}
+
+// Delegates to another constructor, so the destructor cleans up
+// the nodes linked so far if allocation fails midway
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename TInputIterator>
+SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator, TCompare>::
+    SequentialSkipListSet(const AllocatorHandle& allocator,
+                          TInputIterator first, TInputIterator last)
+    : SequentialSkipListSet(allocator) {
+  auto last_nodes = NodePtrList(kMaxLevel + 1, head_);
+  for (; first != last; ++first) {
+    Append(New(GenerateRandomLevel(), *first), last_nodes);
   }
 }
 
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename TInputIterator>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::FromSorted(
+    TInputIterator first, TInputIterator last, const AllocatorHandle& allocator)
+    -> SequentialSkipListSet {
+  return SequentialSkipListSet(allocator, first, last);
+}
+
+// Takes a fresh head from the allocator of `other`, so that `other` stays
+// a valid empty set once the nodes are swapped out of it
+//
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator, TCompare>::
+    SequentialSkipListSet(SequentialSkipListSet&& other)
+    : allocator_(other.allocator_) {
+  Swap(other);
+}
+
+// If nodes may change hands, `other` is moved into a temporary first,
+// so the old nodes are freed there instead of being handed over to `other`.
+// Otherwise they could not be freed through the allocator they end up with,
+// so values of `other` are moved into new nodes of the same levels.
+//
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::operator=(SequentialSkipListSet&& other)
+    -> SequentialSkipListSet& {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (allocator_.Adopts(other.allocator_)) {
+    auto moved = SequentialSkipListSet(std::move(other));
+    allocator_.SwapOnMove(moved.allocator_);
+    SwapContents(moved);
+    return *this;
+  }
+
+  Clear();
+  auto last_nodes = NodePtrList(kMaxLevel + 1, head_);
+  for (auto node = other.head_->Next(); node; node = node->Next()) {
+    Append(New(node->level, std::move(node->value)), last_nodes);
+  }
+  other.Clear();
+
+  return *this;
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                      TCompare>::~SequentialSkipListSet() {
+  // Nodes which are trivially destructible are not visited at all if their
+  // memory goes back in bulk with the last handle to the allocator, which
+  // spares a pointer chase through every node. Containers sharing it reuse
+  // the nodes otherwise, so they are freed one by one, as by `Clear()`.
+  auto releases_in_bulk = false;
+  if constexpr (detail::kReleasesInBulk<TAllocator> &&
+                std::is_trivially_destructible_v<Node>) {
+    releases_in_bulk = allocator_.IsSoleOwner();
+  }
+
+  if (!releases_in_bulk) {
+    DeleteNodes();
+  }
+  Delete(head_);
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Swap(SequentialSkipListSet& other)
+    -> void {
+  allocator_.Swap(other.allocator_);
+  SwapContents(other);
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::SwapContents(SequentialSkipListSet& other)
+    -> void {
+  std::swap(compare_, other.compare_);
+  std::swap(level_, other.level_);
+  std::swap(size_, other.size_);
+  std::swap(memory_, other.memory_);
+  std::swap(head_, other.head_);
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Find(const T& value) const
+    -> SequentialSkipListSet::Iterator {
+  return Find<T>(value);
+}
+
 // Example: searching for 20 in SkipList illustrated below
 // [kMaxLevel = 4, kProbability = 0.5]
 //
@@ -116,16 +282,201 @@ SequentialSkipListSet<T>::~SequentialSkipListSet() {
 //   16->forward[1]->value = 19 < 20 -> traverse forward
 //   19->forward[1]->value = 21 > 20 -> last level, value not found
 //
-template <typename T>
-auto SequentialSkipListSet<T>::Find(const T& value) const
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename K, typename>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Find(const K& key) const
     -> SequentialSkipListSet::Iterator {
-  if (const auto node = Traverse(value); node && !(value < node->value)) {
-    return Iterator{node.get()};
+  if (const auto node = Traverse(key); node && !compare_(key, node->value)) {
+    return Iterator{node};
   } else {
     return End();
   }
 }
 
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Insert(const T& value)
+    -> std::pair<Iterator, bool> {
+  return InsertValue(value);
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Insert(T&& value)
+    -> std::pair<Iterator, bool> {
+  return InsertValue(std::move(value));
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename... Args>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Emplace(Args&&... args)
+    -> std::pair<Iterator, bool> {
+  return InsertValue(T(std::forward<Args>(args)...));
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Erase(const T& value) -> std::size_t {
+  return Erase<T>(value);
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename K, typename>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Erase(const K& key) -> std::size_t {
+  auto update = NodePtrList{kMaxLevel + 1};
+  const auto node = Traverse(key, &update);
+
+  // Test for inequality with a single comparison
+  // (at this point, key is guaranteed to be lesser or equal to node->value)
+  if (!node || compare_(key, node->value)) {
+    return 0;
+  }
+
+  for (auto level = Level{0}; level <= level_; ++level) {
+    const auto i = static_cast<std::size_t>(level);
+    if (update[i]->Forward(i) != node) {
+      break;
+    }
+    update[i]->Forward(i) = node->Forward(i);
+  }
+  Delete(node);
+  --size_;
+
+  while (level_ > 0 && !head_->Forward(static_cast<std::size_t>(level_))) {
+    --level_;
+  }
+
+  return 1;
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Clear() -> void {
+  DeleteNodes();
+  for (auto level = Level{0}; level <= level_; ++level) {
+    head_->Forward(static_cast<std::size_t>(level)) = nullptr;
+  }
+  level_ = 0;
+  size_ = 0;
+}
+
+// Consecutive values of a sorted range are inserted one after another,
+// hence `update` nodes of the previous one make a good starting point
+// (a `finger`) for the next search. `TraverseFrom` climbs from the bottom
+// level of the finger only as high as the distance between the two values
+// requires, then descends from there instead of from the top of `head_`.
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename TInputIterator>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::InsertRange(
+    TInputIterator first, TInputIterator last) -> std::size_t {
+  auto finger = NodePtrList(kMaxLevel + 1, head_);
+  auto inserted = std::size_t{0};
+
+  for (; first != last; ++first) {
+    auto&& value = *first;
+
+    // Out of order value, the finger is past its position
+    if (finger[0] != head_ && !compare_(finger[0]->value, value)) {
+      std::fill(std::begin(finger), std::end(finger), head_);
+    }
+
+    const auto node = TraverseFrom(value, finger);
+    if (node && !compare_(value, node->value)) {
+      continue;
+    }
+
+    const auto new_node =
+        Link(New(GenerateRandomLevel(), std::forward<decltype(value)>(value)),
+             finger);
+    std::fill(std::begin(finger), std::begin(finger) + new_node->level + 1,
+              new_node);
+    ++inserted;
+  }
+
+  return inserted;
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::LowerBound(const T& value) const
+    -> SequentialSkipListSet::Iterator {
+  return Iterator{Traverse(value)};
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::UpperBound(const T& value) const
+    -> SequentialSkipListSet::Iterator {
+  return EqualRange(value).second;
+}
+
+// Values are unique, so the range holds at most one element
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::EqualRange(const T& value) const
+    -> std::pair<Iterator, Iterator> {
+  const auto node = Traverse(value);
+  if (node && !compare_(value, node->value)) {
+    return {Iterator{node}, Iterator{node->Next()}};
+  }
+  return {Iterator{node}, Iterator{node}};
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Size() const -> std::size_t {
+  return size_;
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Empty() const -> bool {
+  return size_ == 0;
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::MemoryUsage() const
+    -> std::size_t {
+  return memory_;
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Begin() const
+    -> SequentialSkipListSet::Iterator {
+  return Iterator{head_->Next()};
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::End() const
+    -> SequentialSkipListSet::Iterator {
+  return Iterator{nullptr};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 // Example: inserting value 21 with level 2 into SkipList illustrated below
 // [kMaxLevel = 4, kProbability = 0.5]
 //
@@ -177,101 +528,173 @@ auto SequentialSkipListSet<T>::Find(const T& value) const
 // |hd|   | 6|   |13|   |15|   |19|   |21|   |24|   |25|
 // └––┘   └––┘   └––┘   └––┘   └––┘   └––┘   └––┘   └––┘
 //
-template <typename T>
-auto SequentialSkipListSet<T>::Insert(const T& value)
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename TValue>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::InsertValue(TValue&& value)
     -> std::pair<Iterator, bool> {
   auto update = NodePtrList{kMaxLevel + 1};
   const auto node = Traverse(value, &update);
 
-  // Test for equality without using operator==
+  // Test for equality with a single comparison
   // (at this point, value is guaranteed to be lesser or equal to node->value)
-  if (node && !(value < node->value)) {
-    return {Iterator{node.get()}, false};
+  if (node && !compare_(value, node->value)) {
+    return {Iterator{node}, false};
   }
 
-  const auto node_level = GenerateRandomLevel();
-  if (node_level > level_) {
-    std::fill(std::begin(update) + level_ + 1,
-              std::begin(update) + node_level + 1, head_);
-    level_ = node_level;
-  }
+  const auto new_node = New(GenerateRandomLevel(), std::forward<TValue>(value));
+  return {Iterator{Link(new_node, update)}, true};
+}
 
-  const auto new_node = std::make_shared<Node>(value, node_level);
-  for (auto level = Level{0}; level <= node_level; ++level) {
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename K>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Traverse(
+    const K& key, SequentialSkipListSet::NodePtrList* update) const
+    -> SequentialSkipListSet::NodePtr {
+  auto node = head_;
+
+  for (auto level = level_; level >= 0; --level) {
     const auto i = static_cast<std::size_t>(level);
-    new_node->forward[i] = std::exchange(update[i]->forward[i], new_node);
+    while (node->Forward(i) && compare_(node->Forward(i)->value, key)) {
+      node = node->Forward(i);
+    }
+    if (update) {
+      (*update)[i] = node;
+    }
   }
 
-  return {Iterator{new_node.get()}, true};
+  return node->Next();
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::Erase(const T& value) -> std::size_t {
-  auto update = NodePtrList{kMaxLevel + 1};
-  const auto node = Traverse(value, &update);
-
-  // Test for inequality without using operator==
-  // (at this point, value is guaranteed to be lesser or equal to node->value)
-  if (!node || value < node->value) {
-    return 0;
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::TraverseFrom(
+    const T& value, SequentialSkipListSet::NodePtrList& finger) const
+    -> SequentialSkipListSet::NodePtr {
+  // Climb while the next node at the level above still precedes `value`,
+  // predecessors at the levels above that one stay the same
+  auto top = Level{0};
+  while (top < level_) {
+    const auto next = finger[static_cast<std::size_t>(top) + 1]->Forward(
+        static_cast<std::size_t>(top) + 1);
+    if (!next || !compare_(next->value, value)) {
+      break;
+    }
+    ++top;
   }
 
-  for (auto level = Level{0}; level <= level_; ++level) {
+  // `finger[i]` is further than `node` until the latter moves forward
+  auto node = head_;
+  auto moved = false;
+
+  for (auto level = top; level >= 0; --level) {
     const auto i = static_cast<std::size_t>(level);
-    if (update[i]->forward[i] != node) {
-      break;
+    if (!moved) {
+      node = finger[i];
     }
-    update[i]->forward[i] = node->forward[i];
+    while (node->Forward(i) && compare_(node->Forward(i)->value, value)) {
+      node = node->Forward(i);
+      moved = true;
+    }
+    finger[i] = node;
   }
 
-  while (level_ > 0 && !head_->forward[static_cast<std::size_t>(level_)]) {
-    --level_;
+  return node->Next();
+}
+
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Link(
+    SequentialSkipListSet::NodePtr new_node,
+    SequentialSkipListSet::NodePtrList& update)
+    -> SequentialSkipListSet::NodePtr {
+  const auto node_level = new_node->level;
+  if (node_level > level_) {
+    std::fill(std::begin(update) + level_ + 1,
+              std::begin(update) + node_level + 1, head_);
+    level_ = node_level;
   }
 
-  return 1;
-}
+  for (auto level = Level{0}; level <= node_level; ++level) {
+    const auto i = static_cast<std::size_t>(level);
+    new_node->Forward(i) = std::exchange(update[i]->Forward(i), new_node);
+  }
+  ++size_;
 
-template <typename T>
-auto SequentialSkipListSet<T>::Begin() const
-    -> SequentialSkipListSet::Iterator {
-  return Iterator{head_->Next()};
+  return new_node;
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::End() const -> SequentialSkipListSet::Iterator {
-  return Iterator{nullptr};
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Append(
+    SequentialSkipListSet::NodePtr new_node,
+    SequentialSkipListSet::NodePtrList& last_nodes) -> void {
+  const auto node_level = new_node->level;
+  for (auto level = Level{0}; level <= node_level; ++level) {
+    const auto i = static_cast<std::size_t>(level);
+    last_nodes[i]->Forward(i) = new_node;
+    last_nodes[i] = new_node;
+  }
+  level_ = std::max(level_, node_level);
+  ++size_;
 }
 
-////////////////////////////////////////////////////////////////////////////////
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::GenerateRandomLevel() const
+    -> SequentialSkipListSet::Level {
+  return TLevelGenerator::Generate(kMaxLevel);
+}
 
-template <typename T>
-auto SequentialSkipListSet<T>::Traverse(
-    const T& value, SequentialSkipListSet::NodePtrList* update) const
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+template <typename... Args>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::New(Level level, Args&&... args)
     -> SequentialSkipListSet::NodePtr {
-  auto node = head_;
-
-  for (auto level = level_; level >= 0; --level) {
-    const auto i = static_cast<std::size_t>(level);
-    while (node->forward[i] && node->forward[i]->value < value) {
-      node = node->forward[i];
-    }
-    if (update) {
-      (*update)[i] = node;
-    }
+  auto size = Tower::AllocationSize(level);
+  auto raw = allocator_.Allocate(size);
+  try {
+    auto node =
+        Tower::Construct(raw, level, level, std::forward<Args>(args)...);
+    memory_ += allocator_.Footprint(size);
+    return node;
+  } catch (...) {
+    allocator_.Deallocate(raw, size);
+    throw;
   }
+}
 
-  return node->forward[0];
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::Delete(
+    SequentialSkipListSet::NodePtr node) -> void {
+  auto level = node->level;
+  auto size = Tower::AllocationSize(level);
+  Tower::Destroy(node, level);
+  allocator_.Deallocate(node, size);
+  memory_ -= allocator_.Footprint(size);
 }
 
-template <typename T>
-auto SequentialSkipListSet<T>::GenerateRandomLevel() const
-    -> SequentialSkipListSet::Level {
-  auto level = Level{0};
-  while (level < kMaxLevel &&
-         static_cast<Probability>(std::rand()) / RAND_MAX < kProbability) {
-    ++level;
+// Leaves links of `head_` dangling
+//
+template <typename T, int TMaxLevel, class TLevelGenerator, class TAllocator,
+          class TCompare>
+auto SequentialSkipListSet<T, TMaxLevel, TLevelGenerator, TAllocator,
+                           TCompare>::DeleteNodes() -> void {
+  for (auto node = head_->Next(); node;) {
+    auto next = node->Next();
+    Delete(node);
+    node = next;
   }
-  return level;
 }
 
 }  // namespace skipper
@@ -0,0 +1,417 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "skipper/concurrent_map.hpp"
+#include "skipper/concurrent_set.hpp"
+#include "skipper/guarded_set.hpp"
+#include "skipper/lock_free_map.hpp"
+#include "skipper/lock_free_set.hpp"
+#include "skipper/sequential_map.hpp"
+#include "skipper/sequential_set.hpp"
+
+static constexpr auto kThousand = 1'000;
+
+// Counts every allocation made by this binary
+static auto allocations = std::atomic<long>{0};
+
+auto operator new(std::size_t size) -> void* {
+  allocations.fetch_add(1);
+  if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+// Not inlined, otherwise compiler sees `free` applied to what `new` returned
+[[gnu::noinline]] auto operator delete(void* ptr) noexcept -> void {
+  std::free(ptr);
+}
+
+[[gnu::noinline]] auto operator delete(void* ptr,
+                                       std::size_t /*size*/) noexcept -> void {
+  std::free(ptr);
+}
+
+// Returns the number of allocations made by `action`
+template <typename TAction>
+static auto CountAllocations(TAction&& action) -> long {
+  auto before = allocations.load();
+  action();
+  return allocations.load() - before;
+}
+
+TEST_CASE("ConcurrentSkipListSet::Contains does not allocate",
+          "[Allocations]") {
+  auto skip_list = skipper::ConcurrentSkipListSet<int>{};
+  for (auto n = 0; n < kThousand; n += 2) {
+    skip_list.Insert(n);
+  }
+
+  // First pin of a thread registers it within the epoch manager
+  skip_list.Contains(0);
+
+  auto count = CountAllocations([&] {
+    for (auto n = 0; n < kThousand; ++n) {
+      skip_list.Contains(n);
+    }
+  });
+  REQUIRE(count == 0);
+}
+
+TEST_CASE("ConcurrentSkipListSet::Insert allocates only the node",
+          "[Allocations]") {
+  auto skip_list = skipper::ConcurrentSkipListSet<int>{};
+  skip_list.Insert(0);
+
+  for (auto n = 1; n < kThousand; ++n) {
+    REQUIRE(CountAllocations([&] { skip_list.Insert(n); }) == 1);
+  }
+  for (auto n = 0; n < kThousand; ++n) {
+    REQUIRE(CountAllocations([&] { skip_list.Insert(n); }) == 0);
+  }
+}
+
+TEST_CASE("ConcurrentSkipListMap lookups do not allocate", "[Allocations]") {
+  auto skip_list = skipper::ConcurrentSkipListMap<int, int>{};
+  for (auto n = 0; n < kThousand; n += 2) {
+    skip_list.Insert(n, n);
+  }
+  skip_list.Contains(0);
+
+  auto count = CountAllocations([&] {
+    for (auto n = 0; n < kThousand; ++n) {
+      skip_list.Contains(n);
+      skip_list.Get(n);
+    }
+  });
+  REQUIRE(count == 0);
+}
+
+TEST_CASE("LockFreeSkipListSet::Contains does not allocate", "[Allocations]") {
+  auto skip_list = skipper::LockFreeSkipListSet<int>{};
+  for (auto n = 0; n < kThousand; n += 2) {
+    skip_list.Insert(n);
+  }
+  skip_list.Contains(0);
+
+  auto count = CountAllocations([&] {
+    for (auto n = 0; n < kThousand; ++n) {
+      skip_list.Contains(n);
+    }
+  });
+  REQUIRE(count == 0);
+}
+
+TEST_CASE("LockFreeSkipListMap lookups do not allocate", "[Allocations]") {
+  auto skip_list = skipper::LockFreeSkipListMap<int, int>{};
+  for (auto n = 0; n < kThousand; n += 2) {
+    skip_list.Insert(n, n);
+  }
+  skip_list.Contains(0);
+
+  auto count = CountAllocations([&] {
+    for (auto n = 0; n < kThousand; ++n) {
+      skip_list.Contains(n);
+      skip_list.Get(n);
+    }
+  });
+  REQUIRE(count == 0);
+}
+
+TEST_CASE("Transparent lookups do not construct keys", "[Allocations]") {
+  using Generator = skipper::detail::XorShiftLevelGenerator<>;
+  using Map = skipper::ConcurrentSkipListMap<
+      std::string, int, 4, Generator, skipper::detail::SpinLock,
+      std::allocator<std::pair<const std::string, int>>, std::less<>>;
+  using LockFreeMap =
+      skipper::LockFreeSkipListMap<std::string, int, skipper::detail::Arena, 4,
+                                   Generator, std::less<>>;
+
+  // Long enough not to fit into the small string buffer
+  auto key = std::string(100, 'k');
+  auto lookup = std::string_view{key};
+
+  auto skip_list = Map{};
+  auto lock_free = LockFreeMap{};
+  skip_list.Insert(key, 0);
+  lock_free.Insert(key, 0);
+
+  auto found = true;
+  auto count = CountAllocations([&] {
+    for (auto n = 0; n < kThousand; ++n) {
+      found = found && skip_list.Contains(lookup) && lock_free.Contains(lookup);
+    }
+  });
+  REQUIRE(found);
+  REQUIRE(count == 0);
+
+  REQUIRE(skip_list.Erase(lookup));
+  REQUIRE(lock_free.Erase(lookup));
+}
+
+// Keeps track of memory which was not returned yet
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations{0};
+  std::size_t outstanding{0};
+
+ private:
+  auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+    ++allocations;
+    outstanding += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+      -> void override {
+    outstanding -= bytes;
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+
+  auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      -> bool override {
+    return this == &other;
+  }
+};
+
+// Inserts numbers, erases half of them and checks that every node came from
+// `resource` and went back to it
+template <typename TSkipList, typename TInsert, typename TErase>
+static auto CheckResource(TInsert&& insert, TErase&& erase) -> void {
+  auto resource = CountingResource{};
+
+  {
+    auto skip_list = TSkipList{&resource};
+    for (auto n = 0; n < kThousand; ++n) {
+      insert(skip_list, n);
+    }
+    for (auto n = 0; n < kThousand; n += 2) {
+      erase(skip_list, n);
+    }
+
+    REQUIRE(resource.allocations > kThousand);
+    REQUIRE(resource.outstanding > 0);
+  }
+
+  REQUIRE(resource.outstanding == 0);
+}
+
+TEST_CASE("Containers allocate nodes from the given memory resource",
+          "[Allocations]") {
+  using Allocator = std::pmr::polymorphic_allocator<int>;
+  using Generator = skipper::detail::XorShiftLevelGenerator<>;
+  using Lock = skipper::detail::SpinLock;
+
+  auto insert = [](auto& skip_list, int n) { skip_list.Insert(n); };
+  auto insert_pair = [](auto& skip_list, int n) { skip_list.Insert(n, n); };
+  auto erase = [](auto& skip_list, int n) { skip_list.Erase(n); };
+
+  SECTION("Sequential set") {
+    CheckResource<skipper::SequentialSkipListSet<int, 4, Generator, Allocator>>(
+        insert, erase);
+  }
+
+  SECTION("Sequential map") {
+    CheckResource<
+        skipper::SequentialSkipListMap<int, int, 4, Generator, Allocator>>(
+        insert_pair, erase);
+  }
+
+  SECTION("Guarded set") {
+    CheckResource<skipper::GuardedSkipListSet<int, 4, Generator, Allocator>>(
+        [](auto& skip_list, int n) { skip_list->Insert(n); },
+        [](auto& skip_list, int n) { skip_list->Erase(n); });
+  }
+
+  SECTION("Concurrent set") {
+    CheckResource<
+        skipper::ConcurrentSkipListSet<int, 4, Generator, Lock, Allocator>>(
+        insert, erase);
+  }
+
+  SECTION("Concurrent map") {
+    CheckResource<skipper::ConcurrentSkipListMap<int, int, 4, Generator, Lock,
+                                                 Allocator>>(insert_pair,
+                                                             erase);
+  }
+
+  SECTION("Lock-free set") {
+    CheckResource<skipper::LockFreeSkipListSet<int, Allocator>>(insert, erase);
+  }
+
+  SECTION("Lock-free map") {
+    CheckResource<skipper::LockFreeSkipListMap<int, int, Allocator>>(
+        insert_pair, erase);
+  }
+}
+
+// Checks that `MemoryUsage()` is exactly what `resource` has handed out,
+// nodes which are erased but not freed yet included
+template <typename TSkipList, typename TInsert>
+static auto CheckMemoryUsage(TInsert&& insert) -> void {
+  auto resource = CountingResource{};
+  auto skip_list = TSkipList{&resource};
+  REQUIRE(skip_list.MemoryUsage() == resource.outstanding);
+
+  for (auto n = 0; n < kThousand; ++n) {
+    insert(skip_list, n);
+  }
+  REQUIRE(skip_list.Size() == kThousand);
+  REQUIRE(skip_list.MemoryUsage() == resource.outstanding);
+
+  for (auto n = 0; n < kThousand; n += 2) {
+    skip_list.Erase(n);
+  }
+  REQUIRE(skip_list.Size() == kThousand / 2);
+  REQUIRE(skip_list.MemoryUsage() == resource.outstanding);
+}
+
+TEST_CASE("Boxed values come from the container's resource",
+          "[Allocations]") {
+  using Map = skipper::LockFreeSkipListMap<
+      int, std::string, std::pmr::polymorphic_allocator<int>>;
+
+  auto resource = CountingResource{};
+
+  {
+    auto skip_list = Map{&resource};
+    for (auto n = 0; n < kThousand; ++n) {
+      skip_list.Insert(n, "first");
+      skip_list.InsertOrAssign(n, "second");
+    }
+
+    // A node and two boxes per key
+    REQUIRE(resource.allocations >= 3 * kThousand);
+    REQUIRE(skip_list.MemoryUsage() == resource.outstanding);
+  }
+
+  REQUIRE(resource.outstanding == 0);
+}
+
+TEST_CASE("MemoryUsage() matches memory taken from the resource",
+          "[Allocations]") {
+  using Allocator = std::pmr::polymorphic_allocator<int>;
+  using Generator = skipper::detail::XorShiftLevelGenerator<>;
+  using Lock = skipper::detail::SpinLock;
+
+  auto insert = [](auto& skip_list, int n) { skip_list.Insert(n); };
+  auto insert_pair = [](auto& skip_list, int n) { skip_list.Insert(n, n); };
+
+  SECTION("Sequential set") {
+    CheckMemoryUsage<
+        skipper::SequentialSkipListSet<int, 4, Generator, Allocator>>(insert);
+  }
+
+  SECTION("Sequential map") {
+    CheckMemoryUsage<
+        skipper::SequentialSkipListMap<int, int, 4, Generator, Allocator>>(
+        insert_pair);
+  }
+
+  SECTION("Concurrent set") {
+    CheckMemoryUsage<
+        skipper::ConcurrentSkipListSet<int, 4, Generator, Lock, Allocator>>(
+        insert);
+  }
+
+  SECTION("Lock-free map") {
+    CheckMemoryUsage<skipper::LockFreeSkipListMap<int, int, Allocator>>(
+        insert_pair);
+  }
+
+  SECTION("Lock-free map, boxed values") {
+    CheckMemoryUsage<
+        skipper::LockFreeSkipListMap<int, std::string, Allocator>>(
+        [](auto& skip_list, int n) {
+          skip_list.Insert(n, "first");
+          skip_list.InsertOrAssign(n, "second");
+        });
+  }
+}
+
+TEST_CASE("Moved sequential sets free nodes through their own resource",
+          "[Allocations]") {
+  using Set = skipper::SequentialSkipListSet<
+      int, 4, skipper::detail::XorShiftLevelGenerator<>,
+      std::pmr::polymorphic_allocator<int>>;
+
+  auto resource = CountingResource{};
+
+  {
+    auto skip_list = Set{&resource};
+    for (auto n = 0; n < kThousand; ++n) {
+      skip_list.Insert(n);
+    }
+
+    auto moved = std::move(skip_list);
+    skip_list = Set{&resource};
+    skip_list.Swap(moved);
+    moved = std::move(skip_list);
+
+    REQUIRE(moved.Find(kThousand - 1) != moved.End());
+  }
+
+  REQUIRE(resource.outstanding == 0);
+}
+
+// Move-assigns between containers on separate resources and checks that
+// nodes are freed through the resource they came from
+template <typename TSkipList, typename TInsert>
+static auto CheckMoveAcrossResources(TInsert&& insert) -> void {
+  auto resource = CountingResource{};
+  auto other_resource = CountingResource{};
+
+  {
+    auto skip_list = TSkipList{&resource};
+    auto other = TSkipList{&other_resource};
+    for (auto n = 0; n < kThousand; ++n) {
+      insert(skip_list, n);
+      insert(other, -n);
+    }
+
+    skip_list = std::move(other);
+    REQUIRE(skip_list.Size() == kThousand);
+    REQUIRE(other.Size() == 0);
+    REQUIRE(skip_list.Find(-(kThousand - 1)) != skip_list.End());
+    REQUIRE(skip_list.Find(kThousand - 1) == skip_list.End());
+
+    // Only the heads are left on `other_resource`
+    REQUIRE(skip_list.MemoryUsage() == resource.outstanding);
+    REQUIRE(other.MemoryUsage() == other_resource.outstanding);
+
+    other = std::move(skip_list);
+    REQUIRE(other.Size() == kThousand);
+    REQUIRE(skip_list.MemoryUsage() == resource.outstanding);
+    REQUIRE(other.MemoryUsage() == other_resource.outstanding);
+  }
+
+  REQUIRE(resource.outstanding == 0);
+  REQUIRE(other_resource.outstanding == 0);
+}
+
+TEST_CASE("Move assignment across resources moves values into new nodes",
+          "[Allocations]") {
+  using Allocator = std::pmr::polymorphic_allocator<int>;
+  using Generator = skipper::detail::XorShiftLevelGenerator<>;
+
+  SECTION("Sequential set") {
+    CheckMoveAcrossResources<
+        skipper::SequentialSkipListSet<int, 4, Generator, Allocator>>(
+        [](auto& skip_list, int n) { skip_list.Insert(n); });
+  }
+
+  SECTION("Sequential map") {
+    CheckMoveAcrossResources<skipper::SequentialSkipListMap<
+        int, std::string, 4, Generator, Allocator>>(
+        [](auto& skip_list, int n) {
+          skip_list.Insert(n, std::string(64, 'x'));
+        });
+  }
+}
@@ -1,7 +1,13 @@
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "skipper/detail/arena.hpp"
 
@@ -18,3 +24,120 @@ TEST_CASE("Arena allocates", "[Correctness]") {
 
   REQUIRE(ss.str() == "0 1 4 9 ");
 }
+
+TEST_CASE("Arena deallocates", "[Correctness]") {
+  auto arena = skipper::detail::Arena{};
+
+  auto first = arena.Allocate(sizeof(int));
+  auto second = arena.Allocate(sizeof(int));
+  REQUIRE(first != nullptr);
+  REQUIRE(second != nullptr);
+
+  arena.Deallocate(first, sizeof(int));
+  arena.Deallocate(second, sizeof(int));
+}
+
+TEST_CASE("Arena reuses deallocated blocks of the same size",
+          "[Correctness]") {
+  using skipper::detail::Arena;
+
+  auto arena = Arena{};
+
+  auto small = arena.Allocate(24);
+  auto large = arena.Allocate(Arena::kMaxReusedSize + 1);
+  arena.Deallocate(small, 24);
+  arena.Deallocate(large, Arena::kMaxReusedSize + 1);
+
+  REQUIRE(arena.Allocate(sizeof(int)) != small);
+  REQUIRE(arena.Allocate(32) == small);
+  REQUIRE(arena.Allocate(32) != small);
+  REQUIRE(arena.Allocate(Arena::kMaxReusedSize + 1) != large);
+
+  auto reserved = arena.Reserved();
+  for (auto i = 0; i < 1'000'000; ++i) {
+    arena.Deallocate(arena.Allocate(100), 100);
+  }
+  REQUIRE(arena.Reserved() == reserved);
+}
+
+TEST_CASE("Arena blocks are aligned and do not overlap", "[Correctness]") {
+  using skipper::detail::Arena;
+
+  auto arena = Arena{};
+
+  auto blocks = std::vector<std::pair<char*, std::size_t>>{};
+  for (auto bytes = std::size_t{1}; bytes < 4 * Arena::kSlabSize / 1000;
+       bytes += 7) {
+    auto raw = arena.Allocate(bytes);
+    REQUIRE(raw != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(raw) % Arena::kAlignment == 0);
+    std::memset(raw, 0, bytes);
+    blocks.emplace_back(raw, bytes);
+  }
+
+  std::sort(blocks.begin(), blocks.end());
+  for (auto i = std::size_t{1}; i < blocks.size(); ++i) {
+    REQUIRE(blocks[i - 1].first + blocks[i - 1].second <= blocks[i].first);
+  }
+}
+
+TEST_CASE("Arena grows past a single slab", "[Correctness]") {
+  using skipper::detail::Arena;
+
+  auto arena = Arena{};
+  REQUIRE(arena.Reserved() == 0);
+
+  for (auto i = 0; i < 4; ++i) {
+    auto raw = arena.Allocate(Arena::kSlabSize - Arena::kAlignment);
+    REQUIRE(raw != nullptr);
+    std::memset(raw, 0, Arena::kSlabSize - Arena::kAlignment);
+  }
+  REQUIRE(arena.Reserved() == 4 * Arena::kSlabSize);
+
+  auto huge = arena.Allocate(4 * Arena::kSlabSize);
+  REQUIRE(huge != nullptr);
+  std::memset(huge, 0, 4 * Arena::kSlabSize);
+  REQUIRE(arena.Reserved() == 8 * Arena::kSlabSize);
+}
+
+TEST_CASE("Arena reports exceeded budget", "[Correctness]") {
+  using skipper::detail::Arena;
+
+  auto arena = Arena{2 * Arena::kSlabSize};
+
+  REQUIRE(arena.Allocate(Arena::kSlabSize) != nullptr);
+  REQUIRE(arena.Allocate(Arena::kSlabSize) != nullptr);
+  REQUIRE_THROWS_AS(arena.Allocate(Arena::kAlignment), Arena::BudgetExceeded);
+  REQUIRE_THROWS_AS(arena.Allocate(4 * Arena::kSlabSize),
+                    Arena::BudgetExceeded);
+}
+
+TEST_CASE("Arena is shared by threads", "[Concurrency]") {
+  constexpr auto kThreads = 4;
+  constexpr auto kBlocks = 100'000;
+
+  auto arena = skipper::detail::Arena{};
+  auto blocks = std::vector<std::vector<int*>>(kThreads);
+
+  auto threads = std::vector<std::thread>{};
+  for (auto t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (auto i = 0; i < kBlocks; ++i) {
+        if (auto raw = arena.Allocate(sizeof(int))) {
+          blocks[static_cast<std::size_t>(t)].push_back(new (raw) int{t});
+        }
+      }
+    });
+  }
+
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  for (auto t = 0; t < kThreads; ++t) {
+    REQUIRE(blocks[static_cast<std::size_t>(t)].size() == kBlocks);
+    for (auto number : blocks[static_cast<std::size_t>(t)]) {
+      REQUIRE(*number == t);
+    }
+  }
+}
@@ -1,8 +1,13 @@
 #include <catch2/catch.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "skipper/concurrent_map.hpp"
 
@@ -77,6 +82,100 @@ TEST_CASE("Check Sequential SkipList Map functionality", "[Functionality]") {
       REQUIRE(skip_list.Contains(it->first));
     }
   }
+
+  SECTION("Get() and Visit() return stored values", "[Correctness]") {
+    auto skip_list = SL<int, int>{};
+
+    for (auto n : numbers) {
+      skip_list.Insert(n, n * n);
+    }
+
+    for (auto n : numbers) {
+      REQUIRE(skip_list.Get(n) == n * n);
+
+      auto visited = 0;
+      REQUIRE(skip_list.Visit(n, [&visited](const int& v) { visited = v; }));
+      REQUIRE(visited == n * n);
+    }
+
+    REQUIRE(!skip_list.Get(-1).has_value());
+    REQUIRE(!skip_list.Visit(-1, [](const int&) {}));
+  }
+
+  SECTION("Update() modifies values in place", "[Correctness]") {
+    auto skip_list = SL<int, int>{};
+
+    skip_list.Insert(1, 1);
+    REQUIRE(skip_list.Update(1, [](int& v) { v *= 10; }));
+    REQUIRE(skip_list.Get(1) == 10);
+
+    REQUIRE(skip_list.Erase(1));
+    REQUIRE(!skip_list.Update(1, [](int& v) { v *= 10; }));
+  }
+
+  SECTION("Visit() does not copy the value", "[Correctness]") {
+    // Not copyable at all, so `Visit` has to pass the stored value itself
+    auto skip_list = SL<int, std::unique_ptr<int>>{};
+    REQUIRE(skip_list.TryEmplace(1, std::make_unique<int>(1)));
+
+    const std::unique_ptr<int>* stored = nullptr;
+    REQUIRE(skip_list.Update(1, [&stored](auto& v) { stored = &v; }));
+    REQUIRE(skip_list.Visit(1, [stored](const std::unique_ptr<int>& v) {
+      REQUIRE(&v == stored);
+      REQUIRE(*v == 1);
+    }));
+  }
+}
+
+TEST_CASE("TryEmplace() constructs the value for a new key only",
+          "[Correctness]") {
+  auto skip_list = SL<int, std::string>{};
+
+  REQUIRE(skip_list.TryEmplace(1, "aaa"));
+  REQUIRE_FALSE(skip_list.TryEmplace(1, "bbb"));
+  REQUIRE(skip_list.Get(1) == "aaa");
+
+  auto value = std::string(32, 'c');
+  REQUIRE_FALSE(skip_list.Insert(1, std::move(value)));
+  REQUIRE(value == std::string(32, 'c'));
+  REQUIRE(skip_list.Insert(2, std::move(value)));
+  REQUIRE(skip_list.Get(2) == std::string(32, 'c'));
+}
+
+TEST_CASE("Size() counts keys", "[Correctness]") {
+  auto skip_list = SL<int, int>{};
+  REQUIRE(skip_list.Empty());
+
+  skip_list.Insert(1, 1);
+  skip_list.Insert(1, 2);
+  skip_list.TryEmplace(2, 2);
+  REQUIRE(skip_list.Size() == 2);
+
+  skip_list.Erase(1);
+  REQUIRE(skip_list.Size() == 1);
+  REQUIRE(skip_list.MemoryUsage() > 0);
+}
+
+TEST_CASE("Concurrent updates of the same key are not lost", "[Concurrency]") {
+  auto skip_list = SL<int, int>{};
+  constexpr auto kThreads = 4;
+
+  skip_list.Insert(0, 0);
+
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&skip_list]() {
+      for (auto j = 0; j < 10 * kThousand; ++j) {
+        skip_list.Update(0, [](int& v) { ++v; });
+      }
+    });
+  }
+
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(skip_list.Get(0) == kThreads * 10 * kThousand);
 }
 
 TEST_CASE("Two threads insert repeating numbers simultaneously",
@@ -308,3 +407,67 @@ TEST_CASE(
     t.join();
   }
 }
+
+TEST_CASE("ForEachInRange() visits present keys in ascending order",
+          "[Correctness]") {
+  auto skip_list = SL<int, int>{};
+  for (auto key = 0; key < kThousand; key += 2) {
+    skip_list.Insert(key, -key);
+  }
+  for (auto key = 0; key < kThousand; key += 4) {
+    skip_list.Erase(key);
+  }
+
+  auto visited = std::vector<std::pair<int, int>>{};
+  skip_list.ForEachInRange(101, 201, [&](int key, int value) {
+    visited.emplace_back(key, value);
+  });
+
+  auto expected = std::vector<std::pair<int, int>>{};
+  for (auto key = 102; key < 201; key += 4) {
+    expected.emplace_back(key, -key);
+  }
+  REQUIRE(visited == expected);
+}
+
+TEST_CASE("ForEachInRange() runs alongside inserts and erases",
+          "[Concurrency]") {
+  auto skip_list = SL<int, int>{};
+
+  // Even keys stay in the map, odd ones come and go
+  for (auto key = 0; key < 2 * kThousand; key += 2) {
+    skip_list.Insert(key, key);
+  }
+
+  auto done = std::atomic<bool>{false};
+  auto writer = std::thread([&]() {
+    for (auto round = 0; round < 10; ++round) {
+      for (auto key = 1; key < 2 * kThousand; key += 2) {
+        skip_list.Insert(key, key);
+      }
+      for (auto key = 1; key < 2 * kThousand; key += 2) {
+        skip_list.Erase(key);
+      }
+    }
+    done.store(true);
+  });
+
+  auto consistent = true;
+  auto scanner = std::thread([&]() {
+    while (!done.load()) {
+      auto previous = -1;
+      auto evens = 0;
+      skip_list.ForEachInRange(0, 2 * kThousand, [&](int key, int value) {
+        consistent = consistent && previous < key && key == value;
+        previous = key;
+        evens += key % 2 == 0 ? 1 : 0;
+      });
+      consistent = consistent && evens == kThousand;
+    }
+  });
+
+  writer.join();
+  scanner.join();
+
+  REQUIRE(consistent);
+}
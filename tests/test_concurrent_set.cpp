@@ -1,8 +1,13 @@
 #include <catch2/catch.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "skipper/concurrent_set.hpp"
 #include "skipper/sequential_set.hpp"
@@ -313,3 +318,135 @@ TEST_CASE(
     t.join();
   }
 }
+
+TEST_CASE("Comparator orders values and enables transparent lookups",
+          "[Correctness]") {
+  using Set = skipper::ConcurrentSkipListSet<
+      std::string, 4, skipper::detail::XorShiftLevelGenerator<>,
+      skipper::detail::SpinLock, std::allocator<std::string>, std::greater<>>;
+  auto skip_list = Set{};
+  for (auto word : {"a", "b", "c", "d"}) {
+    skip_list.Insert(word);
+  }
+
+  using namespace std::string_view_literals;
+  REQUIRE(skip_list.Contains("b"sv));
+  REQUIRE(skip_list.Erase("b"sv));
+  REQUIRE_FALSE(skip_list.Contains("b"sv));
+  REQUIRE_FALSE(skip_list.Erase("e"sv));
+
+  auto visited = std::string{};
+  skip_list.ForEachInRange("d", "a",
+                           [&](const std::string& word) { visited += word; });
+  REQUIRE(visited == "dc");
+}
+
+TEST_CASE("Insert() and Emplace() move values into new nodes only",
+          "[Correctness]") {
+  auto skip_list = SL<std::string>{};
+
+  auto word = std::string(32, 'a');
+  REQUIRE(skip_list.Insert(std::move(word)));
+  REQUIRE(skip_list.Contains(std::string(32, 'a')));
+
+  word = std::string(32, 'a');
+  REQUIRE_FALSE(skip_list.Insert(std::move(word)));
+  REQUIRE(word == std::string(32, 'a'));
+
+  REQUIRE(skip_list.Emplace("bbb"));
+  REQUIRE_FALSE(skip_list.Emplace(3u, 'b'));
+  REQUIRE(skip_list.Contains("bbb"));
+}
+
+TEST_CASE("ForEachInRange() visits present values in ascending order",
+          "[Correctness]") {
+  auto skip_list = SL<int>{};
+  for (auto n = 0; n < kThousand; n += 2) {
+    skip_list.Insert(n);
+  }
+  for (auto n = 0; n < kThousand; n += 4) {
+    skip_list.Erase(n);
+  }
+
+  auto visited = std::vector<int>{};
+  skip_list.ForEachInRange(101, 201, [&](int n) { visited.push_back(n); });
+
+  auto expected = std::vector<int>{};
+  for (auto n = 102; n < 201; n += 4) {
+    expected.push_back(n);
+  }
+  REQUIRE(visited == expected);
+}
+
+TEST_CASE("Size() counts values inserted and erased by many threads",
+          "[Concurrency]") {
+  constexpr auto kThreads = 4;
+
+  auto skip_list = SL<int>{};
+
+  auto run = [&](auto&& body) {
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t < kThreads; ++t) {
+      threads.emplace_back(body, t);
+    }
+    for (auto&& thread : threads) {
+      thread.join();
+    }
+  };
+
+  run([&](int /*t*/) {
+    for (auto n = 0; n < kThousand; ++n) {
+      skip_list.Insert(n);
+    }
+  });
+  REQUIRE(skip_list.Size() == kThousand);
+
+  run([&](int t) {
+    for (auto n = t; n < kThousand; n += kThreads) {
+      skip_list.Erase(n);
+    }
+  });
+  REQUIRE(skip_list.Empty());
+}
+
+TEST_CASE("ForEachInRange() runs alongside inserts and erases",
+          "[Concurrency]") {
+  auto skip_list = SL<int>{};
+
+  // Even numbers stay in the set, odd ones come and go
+  for (auto n = 0; n < 2 * kThousand; n += 2) {
+    skip_list.Insert(n);
+  }
+
+  auto done = std::atomic<bool>{false};
+  auto writer = std::thread([&]() {
+    for (auto round = 0; round < 10; ++round) {
+      for (auto n = 1; n < 2 * kThousand; n += 2) {
+        skip_list.Insert(n);
+      }
+      for (auto n = 1; n < 2 * kThousand; n += 2) {
+        skip_list.Erase(n);
+      }
+    }
+    done.store(true);
+  });
+
+  auto consistent = true;
+  auto scanner = std::thread([&]() {
+    while (!done.load()) {
+      auto previous = -1;
+      auto evens = 0;
+      skip_list.ForEachInRange(0, 2 * kThousand, [&](int n) {
+        consistent = consistent && previous < n;
+        previous = n;
+        evens += n % 2 == 0 ? 1 : 0;
+      });
+      consistent = consistent && evens == kThousand;
+    }
+  });
+
+  writer.join();
+  scanner.join();
+
+  REQUIRE(consistent);
+}
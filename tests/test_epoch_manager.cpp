@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "skipper/detail/epoch.hpp"
+
+using skipper::detail::EpochManager;
+
+static constexpr auto kThousand = 1'000;
+
+// Counts destroyed instances
+struct Tracked {
+  explicit Tracked(std::atomic<int>& counter) : freed(counter) {
+  }
+
+  ~Tracked() {
+    freed.fetch_add(1);
+  }
+
+  std::atomic<int>& freed;
+};
+
+TEST_CASE("Retired objects are freed when manager is destroyed",
+          "[Correctness]") {
+  auto freed = std::atomic<int>{0};
+
+  {
+    auto epochs = EpochManager{};
+    auto guard = epochs.Pin();
+    for (auto i = 0; i < 10; ++i) {
+      epochs.Retire(new Tracked{freed});
+    }
+    REQUIRE(freed.load() == 0);
+  }
+
+  REQUIRE(freed.load() == 10);
+}
+
+TEST_CASE("Retired objects are eventually freed without pins",
+          "[Correctness]") {
+  auto freed = std::atomic<int>{0};
+  auto epochs = EpochManager{};
+
+  for (auto i = 0; i < 100 * kThousand; ++i) {
+    epochs.Retire(new Tracked{freed});
+  }
+
+  REQUIRE(freed.load() > 99 * kThousand);
+}
+
+TEST_CASE("Pinned thread keeps retired objects alive", "[Correctness]") {
+  auto freed = std::atomic<int>{0};
+  auto epochs = EpochManager{};
+
+  auto pinned = std::atomic<bool>{false};
+  auto release = std::atomic<bool>{false};
+
+  auto reader = std::thread([&] {
+    auto guard = epochs.Pin();
+    pinned.store(true);
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+  });
+
+  while (!pinned.load()) {
+    std::this_thread::yield();
+  }
+
+  for (auto i = 0; i < 10 * kThousand; ++i) {
+    epochs.Retire(new Tracked{freed});
+  }
+  REQUIRE(freed.load() == 0);
+
+  release.store(true);
+  reader.join();
+
+  for (auto i = 0; i < 10 * kThousand; ++i) {
+    epochs.Retire(new Tracked{freed});
+  }
+  REQUIRE(freed.load() >= 10 * kThousand);
+}
+
+TEST_CASE("Nested pins keep thread pinned until the outermost one ends",
+          "[Correctness]") {
+  auto freed = std::atomic<int>{0};
+  auto epochs = EpochManager{};
+
+  auto outer_pinned = std::atomic<bool>{false};
+  auto inner_released = std::atomic<bool>{false};
+  auto release = std::atomic<bool>{false};
+
+  auto reader = std::thread([&] {
+    auto outer = epochs.Pin();
+    {
+      auto inner = epochs.Pin();
+    }
+    outer_pinned.store(true);
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+  });
+
+  while (!outer_pinned.load()) {
+    std::this_thread::yield();
+  }
+
+  for (auto i = 0; i < 10 * kThousand; ++i) {
+    epochs.Retire(new Tracked{freed});
+  }
+  REQUIRE(freed.load() == 0);
+
+  release.store(true);
+  reader.join();
+}
+
+TEST_CASE("Every retired object is freed exactly once", "[Concurrency]") {
+  constexpr auto kThreads = 8;
+  constexpr auto kRetiresPerThread = 10 * kThousand;
+
+  auto freed = std::atomic<int>{0};
+
+  {
+    auto epochs = EpochManager{};
+    auto threads = std::vector<std::thread>{};
+
+    for (auto t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&] {
+        for (auto i = 0; i < kRetiresPerThread; ++i) {
+          auto guard = epochs.Pin();
+          epochs.Retire(new Tracked{freed});
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  REQUIRE(freed.load() == kThreads * kRetiresPerThread);
+}
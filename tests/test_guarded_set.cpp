@@ -1,8 +1,13 @@
 #include <catch2/catch.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <thread>
+#include <type_traits>
 #include <unordered_set>
+#include <utility>
 
 #include "skipper/guarded_set.hpp"
 
@@ -12,6 +17,9 @@ using Catch::Generators::random;
 template <typename T>
 using GSL = skipper::GuardedSkipListSet<T>;
 
+template <typename T>
+using SGSL = skipper::SharedGuardedSkipListSet<T>;
+
 static constexpr auto kThousand = 1'000;
 
 TEST_CASE("Check Sequential SkipList Map functionality", "[Functionality]") {
@@ -85,6 +93,68 @@ TEST_CASE("Check Sequential SkipList Map functionality", "[Functionality]") {
   }
 }
 
+TEST_CASE("With() applies a batch of operations at once", "[Functionality]") {
+  auto numbers = chunk(kThousand, random(0, kThousand)).get();
+  std::sort(std::begin(numbers), std::end(numbers));
+
+  SECTION("Guarded") {
+    auto skip_list = GSL<int>{};
+
+    auto inserted = skip_list.With([&](auto& sequential) {
+      auto count = 0;
+      for (auto n : numbers) {
+        count += sequential.Insert(n).second ? 1 : 0;
+      }
+      return count;
+    });
+
+    auto unique_numbers =
+        std::unordered_set<int>(std::begin(numbers), std::end(numbers));
+    REQUIRE(inserted == static_cast<int>(unique_numbers.size()));
+  }
+
+  SECTION("Shared guarded") {
+    auto skip_list = SGSL<int>{};
+    skip_list.With([&](auto& sequential) {
+      for (auto n : numbers) {
+        sequential.Insert(n);
+      }
+    });
+
+    auto found = skip_list.WithShared([&](const auto& sequential) {
+      return std::all_of(std::begin(numbers), std::end(numbers), [&](int n) {
+        return sequential.Find(n) != sequential.End();
+      });
+    });
+    REQUIRE(found);
+  }
+}
+
+TEST_CASE("Guarded aliases forward every template parameter",
+          "[Functionality]") {
+  using Generator = skipper::detail::XorShiftLevelGenerator<>;
+  using Sequential = skipper::SequentialSkipListSet<int, 12, Generator,
+                                                    std::allocator<int>,
+                                                    std::greater<int>>;
+  static_assert(
+      std::is_same_v<skipper::GuardedSkipListSet<int, 12, Generator,
+                                                 std::allocator<int>,
+                                                 std::greater<int>>,
+                     skipper::detail::Guarded<Sequential>>);
+  static_assert(
+      std::is_same_v<skipper::SharedGuardedSkipListSet<int, 12>,
+                     skipper::detail::SharedGuarded<
+                         skipper::SequentialSkipListSet<int, 12>>>);
+
+  auto skip_list = skipper::GuardedSkipListSet<int, 12, Generator,
+                                               std::allocator<int>,
+                                               std::greater<int>>{};
+  for (auto n = 0; n < kThousand; ++n) {
+    skip_list->Insert(n);
+  }
+  REQUIRE(*skip_list->Begin() == kThousand - 1);
+}
+
 TEST_CASE(
     "One thread inserts, another is trying to erase non-existent elements",
     "[Concurrency]") {
@@ -116,3 +186,56 @@ TEST_CASE(
     REQUIRE(skip_list->Find(n) == end);
   }
 }
+
+TEST_CASE("Readers of SharedGuardedSkipListSet hold the lock together",
+          "[Concurrency]") {
+  auto skip_list = SGSL<int>{};
+  skip_list->Insert(0);
+
+  auto readers = std::atomic<int>{0};
+  auto read = [&]() {
+    auto proxy = std::as_const(skip_list).operator->();
+    readers.fetch_add(1);
+    // Would never finish if readers excluded each other
+    while (readers.load() < 2) {
+      std::this_thread::yield();
+    }
+    REQUIRE(proxy->Find(0) != proxy->End());
+  };
+
+  auto first = std::thread(read);
+  auto second = std::thread(read);
+
+  first.join();
+  second.join();
+}
+
+TEST_CASE("One thread inserts, another reads SharedGuardedSkipListSet",
+          "[Concurrency]") {
+  auto skip_list = SGSL<int>{};
+
+  auto to_insert = chunk(100 * kThousand, random(0, kThousand)).get();
+  auto to_find =
+      chunk(100 * kThousand, random(2 * kThousand, 3 * kThousand)).get();
+
+  auto inserter = std::thread([&]() {
+    for (auto n : to_insert) {
+      skip_list->Insert(n);
+    }
+  });
+  auto reader = std::thread([&]() {
+    const auto& readonly = skip_list;
+    auto end = readonly->End();
+    for (auto n : to_find) {
+      REQUIRE(readonly->Find(n) == end);
+    }
+  });
+
+  inserter.join();
+  reader.join();
+
+  auto end = skip_list->End();
+  for (auto n : to_insert) {
+    REQUIRE(skip_list->Find(n) != end);
+  }
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "skipper/detail/level_generator.hpp"
+
+using Generator = skipper::detail::XorShiftLevelGenerator<>;
+
+static constexpr auto kThousand = 1'000;
+
+TEST_CASE("Generated levels stay within bounds", "[Correctness]") {
+  for (auto max_level : {0, 1, 4, 16}) {
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      auto level = Generator::Generate(max_level);
+      REQUIRE(level >= 0);
+      REQUIRE(level <= max_level);
+    }
+  }
+}
+
+TEST_CASE("Generated levels follow geometric distribution", "[Correctness]") {
+  constexpr auto kSamples = 100 * kThousand;
+  constexpr auto kMaxLevel = 8;
+
+  auto counts = std::vector<int>(kMaxLevel + 1);
+  for (auto i = 0; i < kSamples; ++i) {
+    ++counts[static_cast<std::size_t>(Generator::Generate(kMaxLevel))];
+  }
+
+  // Roughly 3/4 of nodes stay on the bottom level, 3/16 go one level up
+  REQUIRE(counts[0] > kSamples * 70 / 100);
+  REQUIRE(counts[0] < kSamples * 80 / 100);
+  REQUIRE(counts[1] > kSamples * 16 / 100);
+  REQUIRE(counts[1] < kSamples * 22 / 100);
+}
+
+TEST_CASE("Different threads get different sequences", "[Concurrency]") {
+  constexpr auto kSamples = std::size_t{64};
+
+  auto sample = []() {
+    auto levels = std::vector<int>{};
+    for (auto i = std::size_t{0}; i < kSamples; ++i) {
+      levels.push_back(Generator::Generate(16));
+    }
+    return levels;
+  };
+
+  auto first = std::vector<int>{};
+  auto second = std::vector<int>{};
+
+  auto t1 = std::thread([&]() { first = sample(); });
+  auto t2 = std::thread([&]() { second = sample(); });
+  t1.join();
+  t2.join();
+
+  REQUIRE(first != second);
+}
@@ -0,0 +1,257 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "skipper/lock_free_map.hpp"
+
+using Catch::Generators::chunk;
+using Catch::Generators::random;
+
+template <typename Key, typename Value>
+using SL = skipper::LockFreeSkipListMap<Key, Value>;
+
+static constexpr auto kThousand = 1'000;
+
+TEST_CASE("Check Lock-Free SkipList Map functionality", "[Functionality]") {
+  auto numbers = chunk(kThousand, random(0, 100)).get();
+
+  SECTION("Insert() returns true for new elements and false otherwise",
+          "[Correctness]") {
+    auto skip_list = SL<int, int>{};
+
+    auto unique_numbers = std::unordered_map<int, int>{};
+
+    for (auto n : numbers) {
+      if (unique_numbers.find(n) != std::end(unique_numbers)) {
+        REQUIRE(!skip_list.Insert(n, n));
+      } else {
+        REQUIRE(skip_list.Insert(n, n));
+        unique_numbers.insert({n, n});
+      }
+    }
+  }
+
+  SECTION("Get() returns inserted values", "[Correctness]") {
+    auto skip_list = SL<int, int>{};
+
+    for (auto n : numbers) {
+      skip_list.Insert(n, n * n);
+    }
+
+    for (auto n : numbers) {
+      REQUIRE(skip_list.Contains(n));
+      REQUIRE(skip_list.Get(n) == n * n);
+    }
+
+    REQUIRE(!skip_list.Contains(-1));
+    REQUIRE(!skip_list.Get(-1).has_value());
+  }
+
+  SECTION("InsertOrAssign() replaces values of existing keys",
+          "[Correctness]") {
+    auto skip_list = SL<int, int>{};
+
+    REQUIRE(skip_list.InsertOrAssign(1, 10));
+    REQUIRE(!skip_list.InsertOrAssign(1, 20));
+    REQUIRE(!skip_list.Insert(1, 30));
+    REQUIRE(skip_list.Get(1) == 20);
+  }
+
+  SECTION("Erase() removes requested elements and does not remove other",
+          "[Correctness]") {
+    auto skip_list = SL<int, int>{};
+
+    for (auto n : numbers) {
+      skip_list.Insert(n, n);
+    }
+
+    for (auto n : numbers) {
+      if (n % 2 == 0) {
+        skip_list.Erase(n);
+      }
+    }
+
+    for (auto n : numbers) {
+      REQUIRE(skip_list.Contains(n) == (n % 2 != 0));
+    }
+  }
+
+  SECTION("Values which are not word-sized are supported", "[Correctness]") {
+    auto skip_list = SL<int, std::string>{};
+
+    REQUIRE(skip_list.Insert(1, "one"));
+    REQUIRE(!skip_list.InsertOrAssign(1, std::string(100, 'x')));
+    REQUIRE(skip_list.Get(1) == std::string(100, 'x'));
+
+    REQUIRE(skip_list.Erase(1));
+    REQUIRE(!skip_list.Get(1).has_value());
+  }
+}
+
+TEST_CASE("TryEmplace() constructs the value for a new key only",
+          "[Correctness]") {
+  auto skip_list = SL<int, std::string>{};
+
+  REQUIRE(skip_list.TryEmplace(1, "aaa"));
+  REQUIRE_FALSE(skip_list.TryEmplace(1, "bbb"));
+  REQUIRE(skip_list.Get(1) == "aaa");
+
+  REQUIRE(skip_list.Insert(2, std::string(32, 'c')));
+  REQUIRE(skip_list.Get(2) == std::string(32, 'c'));
+}
+
+TEST_CASE("Two threads insert the same numbers simultaneously",
+          "[Concurrency]") {
+  auto skip_list = SL<int, int>{};
+
+  auto first_numbers = chunk(10 * kThousand, random(0, kThousand)).get();
+  auto second_numbers = first_numbers;
+
+  auto first = std::thread([&]() {
+    for (auto n : first_numbers) {
+      skip_list.Insert(n, n);
+    }
+  });
+
+  auto second = std::thread([&]() {
+    for (auto n : second_numbers) {
+      skip_list.Insert(n, n);
+    }
+  });
+
+  first.join();
+  second.join();
+
+  for (auto n : first_numbers) {
+    REQUIRE(skip_list.Get(n) == n);
+  }
+}
+
+TEST_CASE("Readers never observe partially assigned values", "[Concurrency]") {
+  auto skip_list = SL<int, std::string>{};
+  constexpr auto kKeys = 16;
+
+  for (auto key = 0; key < kKeys; ++key) {
+    skip_list.Insert(key, std::string(64, 'a'));
+  }
+
+  auto writer = std::thread([&]() {
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      auto letter = static_cast<char>('a' + i % 26);
+      skip_list.InsertOrAssign(i % kKeys, std::string(64, letter));
+    }
+  });
+
+  auto reader = std::thread([&]() {
+    for (auto i = 0; i < 10 * kThousand; ++i) {
+      auto value = skip_list.Get(i % kKeys).value();
+      REQUIRE(value == std::string(64, value.front()));
+    }
+  });
+
+  writer.join();
+  reader.join();
+}
+
+TEST_CASE("Threads insert, assign and erase their own keys",
+          "[Concurrency]") {
+  auto skip_list = SL<int, int>{};
+  constexpr auto kThreads = 8;
+  constexpr auto kRange = 10 * kThousand;
+
+  auto routine = [&](int id) {
+    for (auto key = id * kRange; key < (id + 1) * kRange; ++key) {
+      skip_list.Insert(key, 0);
+      skip_list.InsertOrAssign(key, key);
+    }
+    for (auto key = id * kRange + 1; key < (id + 1) * kRange; key += 2) {
+      skip_list.Erase(key);
+    }
+  };
+
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0; i < kThreads; ++i) {
+    threads.emplace_back(routine, i);
+  }
+
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  for (auto key = 0; key < kThreads * kRange; ++key) {
+    if (key % 2 == 0) {
+      REQUIRE(skip_list.Get(key) == key);
+    } else {
+      REQUIRE(!skip_list.Contains(key));
+    }
+  }
+}
+
+TEST_CASE("ForEachInRange() visits present keys in ascending order",
+          "[Correctness]") {
+  auto skip_list = SL<int, int>{};
+  for (auto key = 0; key < kThousand; key += 2) {
+    skip_list.Insert(key, -key);
+  }
+  for (auto key = 0; key < kThousand; key += 4) {
+    skip_list.Erase(key);
+  }
+
+  auto visited = std::vector<std::pair<int, int>>{};
+  skip_list.ForEachInRange(101, 201, [&](int key, int value) {
+    visited.emplace_back(key, value);
+  });
+
+  auto expected = std::vector<std::pair<int, int>>{};
+  for (auto key = 102; key < 201; key += 4) {
+    expected.emplace_back(key, -key);
+  }
+  REQUIRE(visited == expected);
+}
+
+TEST_CASE("ForEachInRange() runs alongside inserts and erases",
+          "[Concurrency]") {
+  auto skip_list = SL<int, int>{};
+
+  // Even keys stay in the map, odd ones come and go
+  for (auto key = 0; key < 2 * kThousand; key += 2) {
+    skip_list.Insert(key, key);
+  }
+
+  auto done = std::atomic<bool>{false};
+  auto writer = std::thread([&]() {
+    for (auto round = 0; round < 10; ++round) {
+      for (auto key = 1; key < 2 * kThousand; key += 2) {
+        skip_list.Insert(key, key);
+      }
+      for (auto key = 1; key < 2 * kThousand; key += 2) {
+        skip_list.Erase(key);
+      }
+    }
+    done.store(true);
+  });
+
+  auto consistent = true;
+  auto scanner = std::thread([&]() {
+    while (!done.load()) {
+      auto previous = -1;
+      auto evens = 0;
+      skip_list.ForEachInRange(0, 2 * kThousand, [&](int key, int value) {
+        consistent = consistent && previous < key && key == value;
+        previous = key;
+        evens += key % 2 == 0 ? 1 : 0;
+      });
+      consistent = consistent && evens == kThousand;
+    }
+  });
+
+  writer.join();
+  scanner.join();
+
+  REQUIRE(consistent);
+}
@@ -1,7 +1,13 @@
 #include <catch2/catch.hpp>
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "skipper/lock_free_set.hpp"
 
@@ -50,6 +56,102 @@ TEST_CASE("Stress test for single thread", "[Correctness]") {
   }
 }
 
+TEST_CASE("Erase() removes requested elements and does not remove other",
+          "[Correctness]") {
+  auto skip_list = SL<int>{};
+
+  auto numbers = chunk(kThousand, random(0, 100)).get();
+  for (auto n : numbers) {
+    skip_list.Insert(n);
+  }
+
+  auto unique_numbers =
+      std::unordered_set<int>{std::begin(numbers), std::end(numbers)};
+  auto half = unique_numbers.size() / 2;
+  auto it = std::begin(unique_numbers);
+  for (auto size = std::size_t{0}; size < half; ++size) {
+    REQUIRE(skip_list.Erase(*it));
+    REQUIRE(!skip_list.Contains(*it));
+    ++it;
+  }
+
+  for (; it != std::end(unique_numbers); ++it) {
+    REQUIRE(skip_list.Contains(*it));
+  }
+}
+
+TEST_CASE("Erased elements can be inserted again", "[Correctness]") {
+  auto skip_list = SL<int>{};
+
+  for (auto round = 0; round < 3; ++round) {
+    for (auto n = 0; n < kThousand; ++n) {
+      REQUIRE(skip_list.Insert(n));
+    }
+    for (auto n = 0; n < kThousand; ++n) {
+      REQUIRE(skip_list.Erase(n));
+      REQUIRE(!skip_list.Erase(n));
+    }
+  }
+
+  for (auto n = 0; n < kThousand; ++n) {
+    REQUIRE(!skip_list.Contains(n));
+  }
+}
+
+TEST_CASE("Insert() throws once the arena budget is exceeded",
+          "[Correctness]") {
+  using skipper::detail::Arena;
+
+  auto skip_list = SL<int>{std::make_shared<Arena>(Arena::kSlabSize)};
+  auto inserted = 0;
+
+  auto insert_all = [&] {
+    while (true) {
+      skip_list.Insert(inserted);
+      ++inserted;
+    }
+  };
+  REQUIRE_THROWS_AS(insert_all(), Arena::BudgetExceeded);
+
+  REQUIRE(inserted > 0);
+  for (auto n = 0; n < inserted; ++n) {
+    REQUIRE(skip_list.Contains(n));
+  }
+  REQUIRE(!skip_list.Contains(inserted));
+}
+
+TEST_CASE("Arena memory stays bounded under insert and erase churn",
+          "[Concurrency]") {
+  using skipper::detail::Arena;
+
+  constexpr auto kThreads = 4;
+  constexpr auto kKeys = 100;
+
+  auto arena = std::make_shared<Arena>();
+  auto skip_list = SL<int>{arena};
+
+  auto threads = std::vector<std::thread>{};
+  for (auto t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (auto round = 0; round < 4 * kThousand; ++round) {
+        for (auto n = t * kKeys; n < (t + 1) * kKeys; ++n) {
+          skip_list.Insert(n);
+        }
+        for (auto n = t * kKeys; n < (t + 1) * kKeys; ++n) {
+          skip_list.Erase(n);
+        }
+      }
+    });
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  // Without reuse the nodes would take about fifty slabs
+  REQUIRE(skip_list.Empty());
+  REQUIRE(arena->Reserved() <= 8 * Arena::kSlabSize);
+}
+
 TEST_CASE("Two threads insert repeating numbers simultaneously",
           "[Concurrency]") {
   auto skip_list = SL<int>{};
@@ -183,3 +285,222 @@ TEST_CASE(
     t.join();
   }
 }
+
+TEST_CASE(
+    "One thread inserts, another is trying to erase non-existent elements",
+    "[Concurrency]") {
+  auto skip_list = SL<int>{};
+
+  auto to_insert = chunk(100 * kThousand, random(0, kThousand)).get();
+  auto to_erase =
+      chunk(100 * kThousand, random(2 * kThousand, 3 * kThousand)).get();
+
+  auto inserter = std::thread([&]() {
+    for (auto n : to_insert) {
+      skip_list.Insert(n);
+    }
+  });
+  auto eraser = std::thread([&]() {
+    for (auto n : to_erase) {
+      skip_list.Erase(n);
+    }
+  });
+
+  inserter.join();
+  eraser.join();
+
+  for (auto n : to_insert) {
+    REQUIRE(skip_list.Contains(n));
+  }
+  for (auto n : to_erase) {
+    REQUIRE(!skip_list.Contains(n));
+  }
+}
+
+TEST_CASE("One thread inserts and second tries to erase the same element",
+          "[Concurrency]") {
+  auto skip_list = SL<int>{};
+
+  int num = 10;
+
+  auto first_numbers = chunk(kThousand, random(num, num)).get();
+  auto second_numbers = chunk(kThousand, random(num, num)).get();
+
+  auto first = std::thread([&]() {
+    for (auto n : first_numbers) {
+      skip_list.Insert(n);
+    }
+  });
+
+  auto second = std::thread([&]() {
+    for (auto n : second_numbers) {
+      skip_list.Erase(n);
+    }
+  });
+
+  first.join();
+  second.join();
+
+  if (!skip_list.Contains(num)) {
+    REQUIRE(skip_list.Insert(num));
+  } else {
+    REQUIRE(skip_list.Erase(num));
+  }
+}
+
+TEST_CASE("Threads insert and erase their own numbers", "[Concurrency]") {
+  auto skip_list = SL<int>{};
+  constexpr auto kThreads = 8;
+  constexpr auto kRange = 10 * kThousand;
+
+  auto routine = [&](int id) {
+    // Every thread erases odd numbers of its own range
+    for (auto n = id * kRange; n < (id + 1) * kRange; ++n) {
+      skip_list.Insert(n);
+    }
+    for (auto n = id * kRange + 1; n < (id + 1) * kRange; n += 2) {
+      skip_list.Erase(n);
+    }
+  };
+
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0; i < kThreads; ++i) {
+    threads.emplace_back(routine, i);
+  }
+
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  for (auto n = 0; n < kThreads * kRange; ++n) {
+    REQUIRE(skip_list.Contains(n) == (n % 2 == 0));
+  }
+}
+
+TEST_CASE("Comparator orders values and enables transparent lookups",
+          "[Correctness]") {
+  using Set = skipper::LockFreeSkipListSet<
+      std::string, skipper::detail::Arena, 4,
+      skipper::detail::XorShiftLevelGenerator<>, std::greater<>>;
+  auto skip_list = Set{};
+  for (auto word : {"a", "b", "c", "d"}) {
+    skip_list.Insert(word);
+  }
+
+  using namespace std::string_view_literals;
+  REQUIRE(skip_list.Contains("b"sv));
+  REQUIRE(skip_list.Erase("b"sv));
+  REQUIRE_FALSE(skip_list.Contains("b"sv));
+  REQUIRE_FALSE(skip_list.Erase("e"sv));
+
+  auto visited = std::string{};
+  skip_list.ForEachInRange("d", "a",
+                           [&](const std::string& word) { visited += word; });
+  REQUIRE(visited == "dc");
+}
+
+TEST_CASE("Insert() and Emplace() move values into new nodes",
+          "[Correctness]") {
+  auto skip_list = SL<std::string>{};
+
+  auto word = std::string(32, 'a');
+  REQUIRE(skip_list.Insert(std::move(word)));
+  REQUIRE(skip_list.Contains(std::string(32, 'a')));
+
+  REQUIRE(skip_list.Emplace("bbb"));
+  REQUIRE_FALSE(skip_list.Emplace(3u, 'b'));
+  REQUIRE(skip_list.Contains("bbb"));
+}
+
+TEST_CASE("ForEachInRange() visits present values in ascending order",
+          "[Correctness]") {
+  auto skip_list = SL<int>{};
+  for (auto n = 0; n < kThousand; n += 2) {
+    skip_list.Insert(n);
+  }
+  for (auto n = 0; n < kThousand; n += 4) {
+    skip_list.Erase(n);
+  }
+
+  auto visited = std::vector<int>{};
+  skip_list.ForEachInRange(101, 201, [&](int n) { visited.push_back(n); });
+
+  auto expected = std::vector<int>{};
+  for (auto n = 102; n < 201; n += 4) {
+    expected.push_back(n);
+  }
+  REQUIRE(visited == expected);
+}
+
+TEST_CASE("Size() counts values inserted and erased by many threads",
+          "[Concurrency]") {
+  constexpr auto kThreads = 4;
+
+  auto skip_list = SL<int>{};
+
+  auto run = [&](auto&& body) {
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t < kThreads; ++t) {
+      threads.emplace_back(body, t);
+    }
+    for (auto&& thread : threads) {
+      thread.join();
+    }
+  };
+
+  run([&](int /*t*/) {
+    for (auto n = 0; n < kThousand; ++n) {
+      skip_list.Insert(n);
+    }
+  });
+  REQUIRE(skip_list.Size() == kThousand);
+
+  run([&](int t) {
+    for (auto n = t; n < kThousand; n += kThreads) {
+      skip_list.Erase(n);
+    }
+  });
+  REQUIRE(skip_list.Empty());
+}
+
+TEST_CASE("ForEachInRange() runs alongside inserts and erases",
+          "[Concurrency]") {
+  auto skip_list = SL<int>{};
+
+  // Even numbers stay in the set, odd ones come and go
+  for (auto n = 0; n < 2 * kThousand; n += 2) {
+    skip_list.Insert(n);
+  }
+
+  auto done = std::atomic<bool>{false};
+  auto writer = std::thread([&]() {
+    for (auto round = 0; round < 10; ++round) {
+      for (auto n = 1; n < 2 * kThousand; n += 2) {
+        skip_list.Insert(n);
+      }
+      for (auto n = 1; n < 2 * kThousand; n += 2) {
+        skip_list.Erase(n);
+      }
+    }
+    done.store(true);
+  });
+
+  auto consistent = true;
+  auto scanner = std::thread([&]() {
+    while (!done.load()) {
+      auto previous = -1;
+      auto evens = 0;
+      skip_list.ForEachInRange(0, 2 * kThousand, [&](int n) {
+        consistent = consistent && previous < n;
+        previous = n;
+        evens += n % 2 == 0 ? 1 : 0;
+      });
+      consistent = consistent && evens == kThousand;
+    }
+  });
+
+  writer.join();
+  scanner.join();
+
+  REQUIRE(consistent);
+}
@@ -0,0 +1,48 @@
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "skipper/detail/per_thread.hpp"
+
+using skipper::detail::PerThread;
+
+TEST_CASE("Every thread gets its own instance", "[Concurrency]") {
+  constexpr auto kThreads = 8;
+  constexpr auto kIncrements = 10'000;
+
+  auto counters = PerThread<int>{};
+
+  auto threads = std::vector<std::thread>{};
+  for (auto t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (auto i = 0; i < kIncrements; ++i) {
+        ++counters.Local();
+      }
+    });
+  }
+
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  auto total = 0;
+  counters.ForEach([&](int& counter) {
+    REQUIRE((counter == 0 || counter % kIncrements == 0));
+    total += counter;
+  });
+
+  REQUIRE(total == kThreads * kIncrements);
+}
+
+TEST_CASE("Instance of an exited thread is reused", "[Correctness]") {
+  auto instances = PerThread<int>{};
+
+  auto first = static_cast<int*>(nullptr);
+  std::thread([&] { first = &instances.Local(); }).join();
+
+  auto second = static_cast<int*>(nullptr);
+  std::thread([&] { second = &instances.Local(); }).join();
+
+  REQUIRE(first == second);
+}
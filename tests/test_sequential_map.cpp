@@ -1,7 +1,11 @@
 #include <catch2/catch.hpp>
 
+#include <functional>
+#include <memory>
 #include <set>
 #include <sstream>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -80,3 +84,153 @@ TEST_CASE("Check Sequential SkipList Map functionality", "[Functionality]") {
     REQUIRE(skip_list.Find(1) == skip_list.End());
   }
 }
+
+TEST_CASE("InsertRange() keeps values of present keys", "[Insert]") {
+  auto skip_list = SM<int, int>{};
+  skip_list.Insert(2, 0);
+
+  auto pairs = std::vector<std::pair<int, int>>{};
+  for (auto key = 0; key < 1'000; ++key) {
+    pairs.emplace_back(key, key);
+  }
+
+  REQUIRE(skip_list.InsertRange(std::begin(pairs), std::end(pairs)) == 999);
+  REQUIRE(skip_list.Find(2)->value == 0);
+
+  auto it = skip_list.Begin();
+  for (auto key = 0; key < 1'000; ++key, ++it) {
+    REQUIRE(it->key == key);
+  }
+  REQUIRE(it == skip_list.End());
+}
+
+TEST_CASE("FromSorted() builds map from sorted pairs", "[Insert]") {
+  auto pairs = std::vector<std::pair<int, int>>{};
+  for (auto key = 0; key < 1'000; ++key) {
+    pairs.emplace_back(key, -key);
+  }
+
+  auto skip_list = SM<int, int>::FromSorted(std::begin(pairs), std::end(pairs));
+
+  for (auto key = 0; key < 1'000; ++key) {
+    REQUIRE(skip_list.Find(key)->value == -key);
+  }
+  REQUIRE(!skip_list.Insert(0, 0).second);
+  REQUIRE(skip_list.Insert(1'000, 0).second);
+}
+
+TEST_CASE("LowerBound() and UpperBound() bound a range scan", "[Find]") {
+  auto skip_list = SM<int, int>{};
+  for (auto key = 0; key < 100; key += 10) {
+    skip_list.Insert(key, key);
+  }
+
+  auto sum = 0;
+  for (auto it = skip_list.LowerBound(15); it != skip_list.UpperBound(60);
+       ++it) {
+    sum += it->value;
+  }
+  REQUIRE(sum == 20 + 30 + 40 + 50 + 60);
+
+  auto [first, last] = skip_list.EqualRange(30);
+  REQUIRE(first->key == 30);
+  REQUIRE(last->key == 40);
+
+  auto [empty_first, empty_last] = skip_list.EqualRange(35);
+  REQUIRE(empty_first == empty_last);
+  REQUIRE(empty_first->key == 40);
+
+  REQUIRE(skip_list.LowerBound(100) == skip_list.End());
+}
+
+TEST_CASE("Transparent comparator enables lookups by other key types",
+          "[Compare]") {
+  using Map = skipper::SequentialSkipListMap<
+      std::string, int, 4, skipper::detail::XorShiftLevelGenerator<>,
+      std::allocator<std::pair<const std::string, int>>, std::less<>>;
+  auto skip_list = Map{};
+  skip_list.Insert("one", 1);
+  skip_list.Insert("two", 2);
+
+  using namespace std::string_view_literals;
+  REQUIRE(skip_list.Find("two"sv)->value == 2);
+  REQUIRE(skip_list.Find("three"sv) == skip_list.End());
+
+  REQUIRE(skip_list.Erase("one"sv) == 1);
+  REQUIRE(skip_list.Find("one"sv) == skip_list.End());
+}
+
+TEST_CASE("TryEmplace() moves arguments only into a new node", "[Insert]") {
+  auto skip_list = SM<int, std::unique_ptr<int>>{};
+
+  auto ptr = std::make_unique<int>(1);
+  REQUIRE(skip_list.Insert(1, std::move(ptr)).second);
+  REQUIRE(*skip_list.Find(1)->value == 1);
+
+  auto other = std::make_unique<int>(2);
+  REQUIRE_FALSE(skip_list.TryEmplace(1, std::move(other)).second);
+  REQUIRE(other != nullptr);
+  REQUIRE(skip_list.TryEmplace(2, std::move(other)).second);
+  REQUIRE(other == nullptr);
+
+  REQUIRE(*skip_list.Find(2)->value == 2);
+  REQUIRE(skip_list[3] == nullptr);
+}
+
+TEST_CASE("Moves and Swap() hand nodes over in O(1)", "[Move]") {
+  auto rebuild = [](int version) {
+    auto skip_list = SM<int, int>{};
+    skip_list.Insert(version, version);
+    return skip_list;
+  };
+
+  auto index = rebuild(1);
+  auto moved = std::move(index);
+  REQUIRE(moved.Find(1)->value == 1);
+  REQUIRE(index.Begin() == index.End());  // NOLINT (use after move)
+
+  index = rebuild(2);
+  auto front = index.Begin();
+  moved.Swap(index);
+  REQUIRE(moved.Begin() == front);
+  REQUIRE(moved[2] == 2);
+  REQUIRE(index.Find(1)->value == 1);
+
+  index = std::move(moved);
+  REQUIRE(index.Find(1) == index.End());
+  REQUIRE(index.Find(2)->value == 2);
+}
+
+TEST_CASE("Size() counts keys", "[Size]") {
+  auto skip_list = SM<int, int>{};
+  REQUIRE(skip_list.Empty());
+
+  skip_list.Insert(1, 1);
+  skip_list.TryEmplace(1, 2);
+  skip_list[2] = 2;
+  REQUIRE(skip_list.Size() == 2);
+
+  const auto usage = skip_list.MemoryUsage();
+  skip_list.Erase(1);
+  REQUIRE(skip_list.Size() == 1);
+  REQUIRE(skip_list.MemoryUsage() < usage);
+
+  auto pairs = std::vector<std::pair<int, int>>{{1, 1}, {2, 2}, {3, 3}};
+  auto sorted = SM<int, int>::FromSorted(std::begin(pairs), std::end(pairs));
+  REQUIRE(sorted.Size() == 3);
+}
+
+TEST_CASE("Clear() erases every key", "[Erase]") {
+  auto skip_list = SM<int, std::string>{};
+  for (auto n = 0; n < 100; ++n) {
+    skip_list.Insert(n, std::to_string(n));
+  }
+
+  skip_list.Clear();
+  REQUIRE(skip_list.Empty());
+  REQUIRE(skip_list.Begin() == skip_list.End());
+
+  skip_list[1] = "one";
+  REQUIRE(skip_list.Find(1)->value == "one");
+  REQUIRE(skip_list.Size() == 1);
+}
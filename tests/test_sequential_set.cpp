@@ -1,10 +1,18 @@
 #include <catch2/catch.hpp>
 
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <set>
 #include <sstream>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "skipper/detail/arena.hpp"
 #include "skipper/sequential_set.hpp"
 
 using Catch::Generators::chunk;
@@ -75,6 +83,174 @@ TEST_CASE("Insert() maintains sortedness", "[Insert]") {
   }
 }
 
+TEST_CASE("InsertRange() inserts sorted and unsorted ranges", "[Insert]") {
+  auto skip_list = SL<int>{};
+
+  auto numbers = chunk(100'000, random(-10'000, 10'000)).get();
+  auto sorted_numbers = std::set<int>{std::begin(numbers), std::end(numbers)};
+
+  // Every other number goes in first, so the range interleaves with the list
+  auto half = std::vector<int>{};
+  for (auto n : sorted_numbers) {
+    if (n % 2 == 0) {
+      half.push_back(n);
+    }
+  }
+  REQUIRE(skip_list.InsertRange(std::begin(half), std::end(half)) ==
+          half.size());
+
+  // Unsorted, with duplicates of each other and of present numbers
+  REQUIRE(skip_list.InsertRange(std::begin(numbers), std::end(numbers)) ==
+          sorted_numbers.size() - half.size());
+
+  auto it = skip_list.Begin();
+  for (auto n : sorted_numbers) {
+    REQUIRE(*it == n);
+    ++it;
+  }
+  REQUIRE(it == skip_list.End());
+}
+
+// Counts every comparison made by all instances
+struct CountingLess {
+  static inline auto count = std::size_t{0};
+
+  auto operator()(int lhs, int rhs) const -> bool {
+    ++count;
+    return lhs < rhs;
+  }
+};
+
+TEST_CASE("InsertRange() of a sorted range makes O(1) comparisons per value",
+          "[Insert]") {
+  using Set = skipper::SequentialSkipListSet<
+      int, 12, skipper::detail::XorShiftLevelGenerator<>, std::allocator<int>,
+      CountingLess>;
+
+  constexpr auto kValues = 100'000;
+  auto numbers = std::vector<int>(kValues);
+  std::iota(std::begin(numbers), std::end(numbers), 0);
+
+  auto skip_list = Set{};
+  CountingLess::count = 0;
+  REQUIRE(skip_list.InsertRange(std::begin(numbers), std::end(numbers)) ==
+          kValues);
+  // Descending from the top of `head_` makes about ten per value here
+  REQUIRE(CountingLess::count < 4 * kValues);
+
+  // Right after the present values
+  auto tail = std::vector<int>(kValues);
+  std::iota(std::begin(tail), std::end(tail), kValues);
+  CountingLess::count = 0;
+  REQUIRE(skip_list.InsertRange(std::begin(tail), std::end(tail)) == kValues);
+  REQUIRE(CountingLess::count < 4 * kValues);
+}
+
+TEST_CASE("FromSorted() builds SL which supports further updates",
+          "[Insert]") {
+  auto numbers = std::vector<int>{};
+  for (auto n = 0; n < 10'000; n += 2) {
+    numbers.push_back(n);
+  }
+
+  auto skip_list = SL<int>::FromSorted(std::begin(numbers), std::end(numbers));
+
+  auto it = skip_list.Begin();
+  for (auto n : numbers) {
+    REQUIRE(skip_list.Find(n) == it);
+    ++it;
+  }
+  REQUIRE(it == skip_list.End());
+
+  for (auto n = 1; n < 10'000; n += 2) {
+    REQUIRE(skip_list.Insert(n).second);
+  }
+  for (auto n : numbers) {
+    REQUIRE(skip_list.Erase(n) == 1);
+  }
+
+  it = skip_list.Begin();
+  for (auto n = 1; n < 10'000; n += 2) {
+    REQUIRE(*it == n);
+    ++it;
+  }
+  REQUIRE(it == skip_list.End());
+}
+
+TEST_CASE("LowerBound() and UpperBound() agree with std::set", "[Find]") {
+  auto skip_list = SL<int>{};
+  auto set = std::set<int>{};
+
+  auto numbers = chunk(1'000, random(-1'000, 1'000)).get();
+  for (auto n : numbers) {
+    skip_list.Insert(n);
+    set.insert(n);
+  }
+
+  // Converts iterator to the value it points to, `std::nullopt` for the end
+  auto value = [](auto it, auto end) {
+    return it == end ? std::nullopt : std::optional<int>{*it};
+  };
+
+  for (auto n = -1'010; n <= 1'010; ++n) {
+    REQUIRE(value(skip_list.LowerBound(n), skip_list.End()) ==
+            value(set.lower_bound(n), set.end()));
+    REQUIRE(value(skip_list.UpperBound(n), skip_list.End()) ==
+            value(set.upper_bound(n), set.end()));
+
+    auto [first, last] = skip_list.EqualRange(n);
+    REQUIRE((first != last) == (set.count(n) == 1));
+  }
+}
+
+// Orders numbers by absolute value, so `n` and `-n` are equivalent
+struct ByAbs {
+  auto operator()(int lhs, int rhs) const -> bool {
+    return std::abs(lhs) < std::abs(rhs);
+  }
+};
+
+TEST_CASE("Comparator defines both order and equality", "[Compare]") {
+  using Set = skipper::SequentialSkipListSet<
+      int, 4, skipper::detail::XorShiftLevelGenerator<>, std::allocator<int>,
+      ByAbs>;
+  auto skip_list = Set{};
+
+  for (auto n : {3, -1, 2, -3, 1}) {
+    skip_list.Insert(n);
+  }
+  REQUIRE(skip_list.Insert(-2).second == false);
+  REQUIRE(*skip_list.Find(-3) == 3);
+
+  auto stream = std::ostringstream{};
+  for (auto it = skip_list.Begin(); it != skip_list.End(); ++it) {
+    stream << *it << ' ';
+  }
+  REQUIRE(stream.str() == "-1 2 3 ");
+
+  REQUIRE(skip_list.Erase(1) == 1);
+  REQUIRE(skip_list.Find(-1) == skip_list.End());
+}
+
+TEST_CASE("Transparent comparator enables lookups by other types",
+          "[Compare]") {
+  using Set = skipper::SequentialSkipListSet<
+      std::string, 4, skipper::detail::XorShiftLevelGenerator<>,
+      std::allocator<std::string>, std::less<>>;
+  auto skip_list = Set{};
+  for (auto word : {"lorem", "ipsum", "dolor"}) {
+    skip_list.Insert(word);
+  }
+
+  using namespace std::string_view_literals;
+  REQUIRE(*skip_list.Find("ipsum"sv) == "ipsum");
+  REQUIRE(skip_list.Find("amet"sv) == skip_list.End());
+
+  REQUIRE(skip_list.Erase("lorem"sv) == 1);
+  REQUIRE(skip_list.Erase("lorem"sv) == 0);
+  REQUIRE(*skip_list.Begin() == "dolor");
+}
+
 TEST_CASE("Erase() does nothing if SL is empty", "[Erase]") {
   auto skip_list = SL<int>{};
   REQUIRE(skip_list.Erase(0) == 0);
@@ -184,17 +360,21 @@ auto operator<(const MovableOnly& left, const MovableOnly& right) -> bool {
   return left.value < right.value;
 }
 
-TEST_CASE("Insert() supports movable-only objects", "[!hide]") {
+TEST_CASE("Insert() supports movable-only objects", "[Insert]") {
   using SLuptr = SL<std::unique_ptr<int>>;
+  static_assert(SLuptr::kSupportsMove);
 
-  if constexpr (SLuptr::kSupportsMove) {
+  {
     auto skip_list = SLuptr{};
     auto ptr = std::make_unique<int>(0);
-    skip_list.Insert(std::move(ptr));
+    auto raw = ptr.get();
+    REQUIRE(skip_list.Insert(std::move(ptr)).second);
+    REQUIRE(skip_list.Begin()->get() == raw);
   }
 
   using SLmo = SL<MovableOnly>;
-  if constexpr (SLmo::kSupportsMove) {
+
+  SECTION("Insert()") {
     auto ss = std::stringstream{};
     {
       auto skip_list = SLmo{};
@@ -203,4 +383,205 @@ TEST_CASE("Insert() supports movable-only objects", "[!hide]") {
     }
     REQUIRE(ss.str() == "ctor dtor");
   }
+
+  SECTION("Emplace()") {
+    auto ss = std::stringstream{};
+    {
+      auto skip_list = SLmo{};
+      REQUIRE(skip_list.Emplace(&ss).second);
+      REQUIRE_FALSE(skip_list.Emplace(nullptr).second);
+    }
+    REQUIRE(ss.str() == "ctor dtor");
+  }
+}
+
+TEST_CASE("Moves hand nodes over and leave the source empty", "[Move]") {
+  auto make = [](int n) {
+    auto skip_list = SL<int>{};
+    for (auto i = 0; i < n; ++i) {
+      skip_list.Insert(i);
+    }
+    return skip_list;
+  };
+
+  auto skip_list = make(3);
+  auto first = skip_list.Begin();
+
+  SECTION("Move constructor") {
+    auto moved = std::move(skip_list);
+    REQUIRE(moved.Begin() == first);
+    REQUIRE(moved.Find(2) != moved.End());
+    REQUIRE(skip_list.Begin() == skip_list.End());  // NOLINT (use after move)
+
+    REQUIRE(skip_list.Insert(5).second);  // NOLINT (use after move)
+    REQUIRE(*skip_list.Begin() == 5);
+  }
+
+  SECTION("Move assignment") {
+    skip_list = make(5);
+    REQUIRE(skip_list.Find(4) != skip_list.End());
+
+    auto other = make(1);
+    skip_list = std::move(other);
+    REQUIRE(skip_list.Find(1) == skip_list.End());
+    REQUIRE(other.Begin() == other.End());  // NOLINT (use after move)
+  }
+
+  SECTION("Containers can be kept in a vector") {
+    auto sets = std::vector<SL<int>>{};
+    for (auto n = 1; n <= 10; ++n) {
+      sets.push_back(make(n));
+    }
+    REQUIRE(sets.front().Begin() != sets.front().End());
+    REQUIRE(sets.back().Find(9) != sets.back().End());
+  }
+}
+
+TEST_CASE("Swap() exchanges contents and keeps iterators valid", "[Move]") {
+  auto left = SL<int>{};
+  auto right = SL<int>{};
+  left.Insert(1);
+  right.Insert(2);
+  right.Insert(3);
+
+  auto two = right.Find(2);
+  left.Swap(right);
+
+  REQUIRE(left.Begin() == two);
+  REQUIRE(*++two == 3);
+  REQUIRE(left.Find(1) == left.End());
+  REQUIRE(*right.Begin() == 1);
+}
+
+TEST_CASE("Size() and MemoryUsage() follow every update", "[Size]") {
+  auto skip_list = SL<int>{};
+  REQUIRE(skip_list.Empty());
+  REQUIRE(skip_list.Size() == 0);
+
+  const auto empty_usage = skip_list.MemoryUsage();
+  REQUIRE(empty_usage > 0);
+
+  skip_list.Insert(1);
+  skip_list.Insert(1);
+  skip_list.Emplace(2);
+  auto values = std::vector<int>{2, 3, 4};
+  REQUIRE(skip_list.InsertRange(std::begin(values), std::end(values)) == 2);
+  REQUIRE(skip_list.Size() == 4);
+  REQUIRE_FALSE(skip_list.Empty());
+  REQUIRE(skip_list.MemoryUsage() > empty_usage);
+
+  REQUIRE(skip_list.Erase(3) == 1);
+  REQUIRE(skip_list.Erase(3) == 0);
+  REQUIRE(skip_list.Size() == 3);
+
+  auto moved = std::move(skip_list);
+  REQUIRE(moved.Size() == 3);
+  REQUIRE(skip_list.Size() == 0);  // NOLINT (use after move)
+  REQUIRE(skip_list.MemoryUsage() == empty_usage);
+
+  for (auto value : {1, 2, 4}) {
+    moved.Erase(value);
+  }
+  REQUIRE(moved.Empty());
+  REQUIRE(moved.MemoryUsage() == empty_usage);
+
+  auto sorted = SL<int>::FromSorted(std::begin(values), std::end(values));
+  REQUIRE(sorted.Size() == values.size());
+}
+
+// Fills the set with values made by `make(n)`, clears it and refills it
+template <typename TSkipList, typename TMake>
+static auto CheckClear(TMake&& make) -> void {
+  auto skip_list = TSkipList{};
+  const auto empty_usage = skip_list.MemoryUsage();
+
+  for (auto n = 0; n < 1'000; ++n) {
+    skip_list.Insert(make(n));
+  }
+  skip_list.Clear();
+
+  REQUIRE(skip_list.Empty());
+  REQUIRE(skip_list.Begin() == skip_list.End());
+  REQUIRE(skip_list.MemoryUsage() == empty_usage);
+  REQUIRE(skip_list.Find(make(0)) == skip_list.End());
+
+  REQUIRE(skip_list.Insert(make(0)).second);
+  REQUIRE(skip_list.Find(make(0)) != skip_list.End());
+  REQUIRE(skip_list.Size() == 1);
+}
+
+TEST_CASE("Clear() empties the set and keeps it usable", "[Erase]") {
+  using Arena = skipper::detail::Arena;
+  using Generator = skipper::detail::XorShiftLevelGenerator<>;
+  static_assert(skipper::detail::kReleasesInBulk<Arena>);
+  static_assert(!skipper::detail::kReleasesInBulk<std::allocator<int>>);
+
+  auto number = [](int n) { return n; };
+  auto string = [](int n) { return std::to_string(n); };
+
+  SECTION("Default allocator") {
+    CheckClear<SL<int>>(number);
+  }
+
+  SECTION("Arena, trivially destructible values") {
+    CheckClear<skipper::SequentialSkipListSet<int, 4, Generator, Arena>>(
+        number);
+  }
+
+  SECTION("Arena, values are destroyed") {
+    CheckClear<skipper::SequentialSkipListSet<std::string, 4, Generator,
+                                              Arena>>(string);
+  }
+
+  SECTION("Arena, nodes are reused after refilling") {
+    auto arena = std::make_shared<Arena>();
+    auto skip_list =
+        skipper::SequentialSkipListSet<int, 4, Generator, Arena>{arena};
+
+    auto reserved = std::size_t{0};
+    for (auto round = 0; round < 20; ++round) {
+      for (auto n = 0; n < 10'000; ++n) {
+        skip_list.Insert(n);
+      }
+      skip_list.Clear();
+
+      // Levels are random, so refills may take a few more blocks of a size
+      if (round == 0) {
+        reserved = arena->Reserved();
+      }
+      REQUIRE(arena->Reserved() <= reserved + Arena::kSlabSize);
+    }
+  }
+}
+
+TEST_CASE("Destroyed sets return nodes to a shared arena", "[Erase]") {
+  using Arena = skipper::detail::Arena;
+  using Set = skipper::SequentialSkipListSet<
+      int, 4, skipper::detail::XorShiftLevelGenerator<>, Arena>;
+
+  auto arena = std::make_shared<Arena>();
+  auto fill = [](Set& skip_list) {
+    for (auto n = 0; n < 10'000; ++n) {
+      skip_list.Insert(n);
+    }
+  };
+
+  auto kept = Set{arena};
+  auto reserved = std::size_t{0};
+  for (auto round = 0; round < 20; ++round) {
+    {
+      auto destroyed = Set{arena};
+      fill(destroyed);
+    }
+
+    // Levels are random, so refills may take a few more blocks of a size
+    if (round == 0) {
+      reserved = arena->Reserved();
+    }
+    REQUIRE(arena->Reserved() <= reserved + Arena::kSlabSize);
+  }
+
+  fill(kept);
+  REQUIRE(kept.Size() == 10'000);
+  REQUIRE(arena->Reserved() <= reserved + Arena::kSlabSize);
 }
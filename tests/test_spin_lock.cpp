@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "skipper/concurrent_set.hpp"
+#include "skipper/detail/spin_lock.hpp"
+
+using skipper::detail::SpinLock;
+
+static constexpr auto kThousand = 1'000;
+
+TEST_CASE("SpinLock takes a single byte", "[Correctness]") {
+  REQUIRE(sizeof(SpinLock) == 1);
+}
+
+TEST_CASE("try_lock() fails while lock is held", "[Correctness]") {
+  auto lock = SpinLock{};
+
+  REQUIRE(lock.try_lock());
+  REQUIRE(!lock.try_lock());
+
+  lock.unlock();
+  REQUIRE(lock.try_lock());
+  lock.unlock();
+}
+
+TEST_CASE("SpinLock provides mutual exclusion", "[Concurrency]") {
+  constexpr auto kThreads = 4;
+
+  auto lock = SpinLock{};
+  auto counter = 0;
+
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < 100 * kThousand; ++j) {
+        auto guard = std::lock_guard{lock};
+        ++counter;
+      }
+    });
+  }
+
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(counter == kThreads * 100 * kThousand);
+}
+
+TEST_CASE("Concurrent containers accept other lock policies",
+          "[Correctness]") {
+  auto skip_list = skipper::ConcurrentSkipListSet<
+      int, 4, skipper::detail::XorShiftLevelGenerator<>, std::mutex>{};
+
+  for (auto n = 0; n < kThousand; ++n) {
+    REQUIRE(skip_list.Insert(n));
+  }
+  for (auto n = 0; n < kThousand; n += 2) {
+    REQUIRE(skip_list.Erase(n));
+  }
+  for (auto n = 0; n < kThousand; ++n) {
+    REQUIRE(skip_list.Contains(n) == (n % 2 != 0));
+  }
+}
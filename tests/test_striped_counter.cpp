@@ -0,0 +1,40 @@
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "skipper/detail/striped_counter.hpp"
+
+using skipper::detail::StripedCounter;
+
+TEST_CASE("StripedCounter sums up signed updates", "[Correctness]") {
+  auto counter = StripedCounter{};
+  REQUIRE(counter.Load() == 0);
+
+  counter.Add(5);
+  counter.Add(-7);
+  REQUIRE(counter.Load() == -2);
+}
+
+TEST_CASE("StripedCounter loses no updates of concurrent threads",
+          "[Concurrency]") {
+  constexpr auto kThreads = 8;
+  constexpr auto kIncrements = 10'000;
+
+  auto counter = StripedCounter{};
+
+  auto threads = std::vector<std::thread>{};
+  for (auto t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (auto i = 0; i < kIncrements; ++i) {
+        counter.Add(t % 2 == 0 ? 2 : -1);
+      }
+    });
+  }
+
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(counter.Load() == kThreads / 2 * kIncrements);
+}